@@ -0,0 +1,197 @@
+#include "AStarSearch.hpp"
+#include "Utils.hpp"
+#include "Timer.hpp"
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include <chrono>
+#include <functional>
+
+
+namespace astar
+{
+	void SearchGraph::build(const std::vector<Node>& nodes)
+	{
+		positions.clear();
+		ids.clear();
+		blocked.clear();
+		offsets.clear();
+		neighbours.clear();
+		costs.clear();
+		positions.reserve(nodes.size());
+		ids.reserve(nodes.size());
+		blocked.reserve(nodes.size());
+		offsets.reserve(nodes.size() + 1);
+		offsets.push_back(0);
+
+		for (const Node& node : nodes)
+		{
+			positions.push_back(node.pos());
+			ids.push_back(node.id());
+			blocked.push_back(node.isCollision());
+
+			for (const Node* neighbour : node.connections_)
+			{
+				neighbours.push_back(static_cast<uint32_t>(neighbour - nodes.data()));
+				costs.push_back(utils::euclidDistance(node.pos(), neighbour->pos()));
+			}
+			offsets.push_back(static_cast<uint32_t>(neighbours.size()));
+		}
+	}
+
+	size_t SearchGraph::size() const
+	{
+		return positions.size();
+	}
+
+	bool SearchScratch::reached(const uint32_t node) const
+	{
+		return node < stamp.size() && stamp[node] == generation;
+	}
+
+	AStarSearch::AStarSearch(const SearchGraph& graph, SearchScratch& scratch, const uint32_t start, const uint32_t end, const bool trace) : graph_{ graph }, scratch_{ scratch },
+		start_{ start }, end_{ end }, state_{ State::Running }, expanded_{}, trace_{ trace }
+	{
+		if (scratch_.stamp.size() < graph_.size())
+		{
+			scratch_.gScore.resize(graph_.size());
+			scratch_.parent.resize(graph_.size());
+			scratch_.stamp.resize(graph_.size());
+		}
+
+		if (++scratch_.generation == 0)
+		{
+			std::ranges::fill(scratch_.stamp, 0u);
+			scratch_.generation = 1;
+		}
+
+		scratch_.goal = end_;
+		scratch_.open.clear();
+		scratch_.stamp[start_] = scratch_.generation;
+		scratch_.gScore[start_] = 0.f;
+		scratch_.parent[start_] = start_;
+		scratch_.open.push_back({ utils::euclidDistance(graph_.positions[start_], graph_.positions[end_]), 0.f, start_ });
+		ASTAR_STAT(++stats_.pushes);
+		ASTAR_STAT(stats_.peakOpen = 1);
+
+		if (trace_)
+		{
+			opened_.push_back(start_);
+		}
+	}
+
+	AStarSearch::State AStarSearch::step(const size_t maxExpansions, const Clock::time_point deadline)
+	{
+		const Timer timer("AStarSearch::step");
+
+		auto& open = scratch_.open;
+		const sf::Vector2f goalPos{ graph_.positions[end_] };
+		size_t remaining{ maxExpansions };
+		for (size_t pops = 1; state_ == State::Running && remaining > 0; pops++)
+		{
+			if (open.empty())
+			{
+				state_ = State::NotFound;
+				break;
+			}
+
+			if (pops % clockCheckInterval_ == 0 && Clock::now() >= deadline) break;
+
+			std::ranges::pop_heap(open, std::greater<>{});
+			const SearchScratch::Entry entry{ open.back() };
+			open.pop_back();
+			ASTAR_STAT(++stats_.pops);
+
+			const uint32_t current{ entry.node };
+			const float gScore{ scratch_.gScore[current] };
+			if (entry.gScore > gScore) continue;
+
+			++expanded_;
+			--remaining;
+
+			if (trace_)
+			{
+				closed_.push_back(current);
+			}
+
+			if (current == end_)
+			{
+				ASTAR_STAT(const auto reconstructionStart = Clock::now());
+				for (uint32_t node = end_;; node = scratch_.parent[node])
+				{
+					path_.push_back(graph_.ids[node]);
+					if (node == start_) break;
+				}
+				std::ranges::reverse(path_);
+				ASTAR_STAT(stats_.reconstructionMicroseconds = std::chrono::duration<float, std::micro>(Clock::now() - reconstructionStart).count());
+
+				state_ = State::Found;
+				break;
+			}
+
+			for (uint32_t edge = graph_.offsets[current]; edge < graph_.offsets[current + 1]; edge++)
+			{
+				const uint32_t neighbour{ graph_.neighbours[edge] };
+				if (graph_.blocked[neighbour]) continue;
+
+				const float tScore{ gScore + graph_.costs[edge] };
+				ASTAR_STAT(++stats_.relaxed);
+
+				const bool seen{ scratch_.stamp[neighbour] == scratch_.generation };
+				if (!seen || tScore < scratch_.gScore[neighbour])
+				{
+					ASTAR_STAT(stats_.decreaseKeys += seen);
+					scratch_.stamp[neighbour] = scratch_.generation;
+					scratch_.gScore[neighbour] = tScore;
+					scratch_.parent[neighbour] = current;
+					open.push_back({ tScore + utils::euclidDistance(graph_.positions[neighbour], goalPos), tScore, neighbour });
+					std::ranges::push_heap(open, std::greater<>{});
+					ASTAR_STAT(++stats_.pushes);
+					ASTAR_STAT(stats_.peakOpen = std::max(stats_.peakOpen, open.size()));
+
+					if (trace_)
+					{
+						opened_.push_back(neighbour);
+					}
+				}
+			}
+		}
+
+		return state_;
+	}
+
+	AStarSearch::State AStarSearch::state() const
+	{
+		return state_;
+	}
+
+	size_t AStarSearch::expanded() const
+	{
+		return expanded_;
+	}
+
+	float AStarSearch::length() const
+	{
+		return state_ == State::Found ? scratch_.gScore[end_] : 0.f;
+	}
+
+	const std::vector<int>& AStarSearch::path() const
+	{
+		return path_;
+	}
+
+	const SearchStats& AStarSearch::stats() const
+	{
+		return stats_;
+	}
+
+	std::vector<uint32_t> AStarSearch::takeOpened()
+	{
+		return std::exchange(opened_, {});
+	}
+
+	std::vector<uint32_t> AStarSearch::takeClosed()
+	{
+		return std::exchange(closed_, {});
+	}
+}
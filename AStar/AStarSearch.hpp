@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+#include "Node.hpp"
+#include "SearchStats.hpp"
+
+
+namespace astar
+{
+	//Read-only copy of a graph the search walks by index, the neighbours of node i are neighbours[offsets[i]] to
+	//neighbours[offsets[i + 1]] and costs holds the length of each of those edges
+	struct SearchGraph
+	{
+		void build(const std::vector<Node>& nodes);
+		size_t size() const;
+		std::vector<sf::Vector2f> positions;
+		std::vector<int32_t> ids;
+		std::vector<uint8_t> blocked;
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> neighbours;
+		std::vector<float> costs;
+	};
+
+	//Scores and parents of one search at a time, stamps avoid clearing the arrays between searches.
+	//Searches running at the same time need one each, the last search's scores stay readable after it's gone
+	struct SearchScratch
+	{
+		struct Entry
+		{
+			float fScore;
+			float gScore; //at the time of the push, a larger one than the node has now marks a stale entry
+			uint32_t node;
+			bool operator>(const Entry& other) const { return fScore > other.fScore; }
+		};
+
+		bool reached(const uint32_t node) const;
+		std::vector<float> gScore;
+		std::vector<uint32_t> parent;
+		std::vector<uint32_t> stamp; //nodes stamped with generation belong to the current search
+		std::vector<Entry> open; //binary heap, smallest fScore first
+		uint32_t generation{};
+		uint32_t goal{};
+	};
+
+	//A* that can be paused after any expansion and resumed later, every search in the program goes through it
+	class AStarSearch
+	{
+	public:
+		enum class State
+		{
+			Running,
+			Found,
+			NotFound
+		};
+
+		using Clock = std::chrono::steady_clock;
+
+		AStarSearch(const SearchGraph& graph, SearchScratch& scratch, const uint32_t start, const uint32_t end, const bool trace = false);
+		State step(const size_t maxExpansions, const Clock::time_point deadline = Clock::time_point::max());
+		State state() const;
+		size_t expanded() const;
+		float length() const;
+		const std::vector<int>& path() const;
+		const SearchStats& stats() const;
+		std::vector<uint32_t> takeOpened();
+		std::vector<uint32_t> takeClosed();
+	private:
+		static constexpr size_t clockCheckInterval_{ 64 }; //expansions between deadline checks
+		const SearchGraph& graph_;
+		SearchScratch& scratch_;
+		uint32_t start_;
+		uint32_t end_;
+		State state_;
+		size_t expanded_;
+		std::vector<int> path_; //node ids, filled once the end is reached
+		SearchStats stats_;
+		bool trace_; //records opened and closed nodes for drawing the frontier
+		std::vector<uint32_t> opened_;
+		std::vector<uint32_t> closed_;
+	};
+}
@@ -6,16 +6,10 @@
 
 namespace astar
 {
-	Connection::Connection(Node* start, Node* end, unsigned int cost, const float distance, const float angle) : start_{ start }, end_{ end }, cost_{ cost }
+	Connection::Connection(Node* start, Node* end, unsigned int cost) : mark_{ Mark::None }, end_{ end }, start_{ start }, cost_{ cost }
 	{
-		line_.setSize({ distance, 5 });
-		line_.setOrigin(0, 2.5);
-		line_.setRotation(angle);
-		line_.setPosition(start->pos());
-		line_.setFillColor(sf::Color(200, 200, 200));
-
 #ifdef _DEBUG
-		std::cout << std::format("adding connection at ({},{}) with angle {} and length {}\n", start->pos().x, start->pos().y, angle, distance);
+		std::cout << std::format("adding connection from ({},{}) to ({},{})\n", start->pos().x, start->pos().y, end->pos().x, end->pos().y);
 #endif
 	}
 }
@@ -1,16 +1,26 @@
 #pragma once
 
-#include <SFML/Graphics.hpp>
+#include <cstdint>
 
 namespace astar 
 {
 	class Node;
+
+	//what the last search made of a Node or Connection, the renderer picks the colours
+	enum class Mark : uint8_t
+	{
+		None,
+		Opened,
+		Closed,
+		Path
+	};
+
 	struct Connection
 	{
-		sf::RectangleShape line_;
+		Mark mark_;
 		Node* end_;
 		Node* start_;
 		unsigned int cost_;
-		Connection(Node* start, Node* end, unsigned int cost, const float distance, const float angle);
+		Connection(Node* start, Node* end, unsigned int cost);
 	};
 }
@@ -1,51 +1,26 @@
 #include "Console.hpp"
+#include "Journal.hpp"
+#include "JobSystem.hpp"
+#include "QueryServer.hpp"
+#include "Timer.hpp"
+#include <SFML/System/Clock.hpp>
 #include <iostream>
 #include <sstream>
 #include <fstream>
 #include <algorithm>
 #include <format>
 #include <filesystem>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <charconv>
+#include <ranges>
+#include <string_view>
+#include "Utils.hpp"
 
 
-namespace
-{
-	template<typename Type>
-	void splitString(std::vector<Type>& vec, std::string str, const char delim)
-	{
-		if constexpr (std::is_same<Type, std::string>::value)
-		{
-			size_t pos;
-			while ((pos = str.find(delim)) != std::string::npos)
-			{
-				vec.emplace_back(str.substr(0, pos));
-				str.erase(0, pos + 1);
-			}
-			vec.emplace_back(str);
-		}
-		else if constexpr (std::is_same<Type, float>::value)
-		{
-			std::vector<Type> temp;
-
-			try
-			{
-				size_t pos;
-				while ((pos = str.find(delim)) != std::string::npos)
-				{
-					temp.emplace_back(std::stof(str.substr(0, pos)));
-					str.erase(0, pos + 1);
-				}
-				temp.emplace_back(std::stof(str));
-			}
-			catch (...)
-			{
-				return;
-			}
-
-			vec = std::move(temp);
-		}
-	}
-}
-
 namespace astar
 {
 	Console& Console::get()
@@ -54,13 +29,21 @@ namespace astar
 		return console;
 	}
 
-	Console::Console() : consoleOpen_{ false }, carriagePos_{ 1 }
+	Console::Console() : depth_{}, echo_{ true }, quiet_{}, scriptLine_{}, scriptErrors_{}
 	{
-		callbacks_.emplace_back("reset", [](const std::vector<std::string>& args) { Graph::get().resetNodes(); }, false);
-		callbacks_.emplace_back("clear", [this](const std::vector<std::string>& args) { history_.clear(); }, false);
-		callbacks_.emplace_back("distance", [](const std::vector<std::string>& args) { Graph::get().toggleDrawDistance(); }, false);
-		callbacks_.emplace_back("conn", [](const std::vector<std::string>& args) { Graph::get().toggleConnectionMode(); }, false);
-		callbacks_.emplace_back("del", [](const std::vector<std::string>& args)
+		output_ = [](const std::string_view line, const Severity severity)
+			{
+				(severity == Severity::Error ? std::cerr : std::cout) << line << '\n';
+			};
+
+		callbacks_.try_emplace("reset", [](const std::vector<std::string>&) { Graph::get().resetNodes(); }, false);
+		callbacks_.try_emplace("jobs", [this](const std::vector<std::string>&) { print("&&G" + JobSystem::get().status()); }, false);
+		callbacks_.try_emplace("cancel", [this](const std::vector<std::string>&)
+			{
+				print(JobSystem::get().cancel() ? "&&Gcancelling running and queued jobs" : "&&Rno jobs to cancel");
+			}, false);
+		callbacks_.try_emplace("conn", [](const std::vector<std::string>&) { Graph::get().toggleConnectionMode(); }, false);
+		callbacks_.try_emplace("del", [](const std::vector<std::string>& args)
 			{
 				try
 				{
@@ -73,14 +56,14 @@ namespace astar
 #endif
 				}
 			}, true);
-		callbacks_.emplace_back("print", [this](const std::vector<std::string>& args)
+		callbacks_.try_emplace("print", [this](const std::vector<std::string>&)
 			{
 				const auto& connections = Graph::get().connectionsCRef();
 				const auto& connectionsCached = Graph::get().connectionsCachedCRef();
 
 				if (connections.empty())
 				{
-					history_.emplace_back("&&Gno connections to print");
+					print("&&Gno connections to print");
 					return;
 				}
 
@@ -90,16 +73,16 @@ namespace astar
 					{
 						ss << connection.first << "<->" << connection.second << '\n';
 					});
-				history_.emplace_back(ss.str());
+				print(ss.str());
 			}, false);
-		callbacks_.emplace_back("link", [this](const std::vector<std::string>& args)
+		callbacks_.try_emplace("link", [this](const std::vector<std::string>& args)
 			{
 				std::vector<int> ids;
 				ids.reserve(args.size());
 
 				if (args.size() < 2)
 				{
-					history_.emplace_back("&&Rincorrect number of arguments, need 2 or more!");
+					print("&&Rincorrect number of arguments, need 2 or more!");
 					return;
 				}
 
@@ -119,28 +102,28 @@ namespace astar
 
 				if (ss.str().size() > 3)
 				{
-					history_.emplace_back(ss.str());
+					print(ss.str());
 				}
 
 				ss.str("");
 				ss << "&&G";
-				for (int i = 1; i < ids.size(); i++)
+				for (int i = 1; i < std::ssize(ids); i++)
 				{
 					if (Graph::get().addIdConnection({ ids[0], ids[i] }))
 					{
 						ss << "adding connection " << ids[0] << "<->" << ids[i] << '\n';
 					}
 				}
-				history_.emplace_back(ss.str());
+				print(ss.str());
 			}, true);
-		callbacks_.emplace_back("path", [this](const std::vector<std::string>& args)
+		callbacks_.try_emplace("path", [this](const std::vector<std::string>& args)
 			{
 				std::vector<int> ids;
 				ids.reserve(args.size());
 
 				if (args.size() < 2)
 				{
-					history_.emplace_back("&&Rincorrect number of arguments, need 2 or more!");
+					print("&&Rincorrect number of arguments, need 2 or more!");
 					return;
 				}
 
@@ -160,12 +143,12 @@ namespace astar
 
 				if (ss.str().size() > 3)
 				{
-					history_.emplace_back(ss.str());
+					print(ss.str());
 				}
 
 				ss.str("");
 				ss << "&&G";
-				for (int i = 0; i < ids.size() - 1; i++)
+				for (int i = 0; i < std::ssize(ids) - 1; i++)
 				{
 					if (Graph::get().addIdConnection({ ids[i], ids[i+1] }))
 					{
@@ -174,16 +157,40 @@ namespace astar
 				}
 				if (ss.str().size() == 3)
 				{
-					history_.emplace_back("&&Rcommand failed");
+					print("&&Rcommand failed");
+					return;
+				}
+				print(ss.str());
+			}, true);
+		callbacks_.try_emplace("unlink", [this](const std::vector<std::string>& args)
+			{
+				if (args.size() != 2)
+				{
+					print("&&Rincorrect number of arguments, need 2!");
 					return;
 				}
-				history_.emplace_back(ss.str());
+
+				try
+				{
+					if (Graph::get().removeIdConnection({ std::stoi(args[0]), std::stoi(args[1]) }))
+					{
+						print("&&Gremoving connection " + args[0] + "<->" + args[1]);
+					}
+					else
+					{
+						print("&&Rconnection " + args[0] + "<->" + args[1] + " doesn't exist!");
+					}
+				}
+				catch (const std::exception& e)
+				{
+					print("&&Rcan't convert arguments to numbers: " + std::string(e.what()));
+				}
 			}, true);
-		callbacks_.emplace_back("set", [this](const std::vector<std::string>& args)
+		callbacks_.try_emplace("set", [this](const std::vector<std::string>& args)
 			{
 				if (args.size() < 2)
 				{
-					history_.emplace_back("&&Rincorrect number of arguments, need 2!");
+					print("&&Rincorrect number of arguments, need 2!");
 					return;
 				}
 
@@ -193,16 +200,16 @@ namespace astar
 					{
 						if (Graph::get().setStart(std::stoi(args[1])))
 						{
-							history_.emplace_back("&&Gstart node id " + args[1]);
+							print("&&Gstart node id " + args[1]);
 						}
 						else
 						{
-							history_.emplace_back("&&Rnode with id " + args[1] + " doesn't exist!");
+							print("&&Rnode with id " + args[1] + " doesn't exist!");
 						}
 					}
 					catch (const std::exception& e)
 					{
-						history_.emplace_back("&&Rcan't convert '" + args[1] + "' to a number: " + e.what());
+						print("&&Rcan't convert '" + args[1] + "' to a number: " + e.what());
 					}
 				}
 				else if (args[0] == "end")
@@ -211,551 +218,885 @@ namespace astar
 					{
 						if (Graph::get().setEnd(std::stoi(args[1])))
 						{
-							history_.emplace_back("&&Gend node id " + args[1]);
+							print("&&Gend node id " + args[1]);
 						}
 						else
 						{
-							history_.emplace_back("&&Rnode with id " + args[1] + " doesn't exist!");
+							print("&&Rnode with id " + args[1] + " doesn't exist!");
 						}
 					}
 					catch (const std::exception& e)
 					{
-						history_.emplace_back("&&Rcan't convert '" + args[1] + "' to a number: " + e.what());
+						print("&&Rcan't convert '" + args[1] + "' to a number: " + e.what());
 					}
 				}
 				else
 				{
-					history_.emplace_back("&&Runknown parameter '" + args[0] + "'!");
+					print("&&Runknown parameter '" + args[0] + "'!");
 				}
 			}, true);
-		callbacks_.emplace_back("load", [this](const std::vector<std::string>& args)
+		callbacks_.try_emplace("load", [this](const std::vector<std::string>& args)
 			{
-				std::fstream file;
-				file.open(args[0], std::ios::in);
-
-				if (!file.is_open())
-				{
-					history_.emplace_back("&&Rcan't open file '" + args[0] + "'!\n");
-					return;
-				}
+				//parsed into a detached graph in the background, the current graph is only replaced once that succeeded
+				JobSystem::get().submit("load " + args[0], [path = args[0]](JobContext& job)
+					{
+						std::ifstream file(path);
 
-				std::string line;
-				std::vector<std::tuple<float, float, int, bool>> splitNodes;
-				std::vector<std::string> stringsToSplit;
+						if (!file.is_open())
+						{
+							job.print("&&Rcan't open file '" + path + "'!\n");
+							return;
+						}
 
-				while (std::getline(file, line) && line != "\n")
+						auto graph = std::make_shared<Graph>();
+						if (graph->readSnapshot(file, [&job](const std::string& line) { job.print(line); }))
+						{
+							job.then([graph] { Graph::get().adopt(*graph); });
+						}
+					});
+			}, true);
+		callbacks_.try_emplace("save", [this](const std::vector<std::string>& args)
+			{
+				if (Graph::get().nodesCRef().empty())
 				{
-					stringsToSplit.push_back(line);
-#ifdef _DEBUG
-					std::cout << line << '\n';
-#endif
+					print("&&Rno nodes to save!\n");
+					return;
 				}
 
-				std::stringstream ss;
-				ss << "&&G";
-
-				Graph::get().resetNodes();
-				std::vector<std::vector<float>> connectionsVec;
+				//formatting and writing run on a copy, so the graph can keep changing meanwhile
+				auto snapshot = Graph::get().searchSnapshot();
 
-				int count{};
-				for (auto& str : stringsToSplit)
-				{
-					++count;
-					if (std::ranges::count(str, ',') != 4)
+				JobSystem::get().submit("save " + args[0], [snapshot, path = args[0]](JobContext& job)
 					{
-						history_.emplace_back("&&Rill formed data '" + str + "' - skipping\n");
-						continue;
-					}
+						std::fstream file;
+						file.open(path, std::ios::out);
 
-					std::vector<std::string> split;
-					splitString(split, str, ',');
+						if (!file.is_open())
+						{
+							job.print("&&Rcan't open file '" + path + "'!\n");
+							return;
+						}
 
-					if (split.size() != 5)
-					{
-						history_.emplace_back(std::format("&&Rnumber of fields in '{}' at line number {} is wrong, expected 5 but got {} - skipping\n", str, count, split.size()));
-						continue;
-					}
+						std::stringstream content;
+						snapshot->writeSnapshot(content);
+						file << content.str();
 
-					std::vector<float> connections;
-					splitString(connections, split.back(), ':');
+						std::stringstream ss;
+						ss << "&&G";
 
-					if (connections.empty())
-					{
-						history_.emplace_back(std::format("&&Rbad argument in '{}' at line number {}  - skipping\n", str, count));
-						continue;
-					}
-					else if (connections.size() < 2)
-					{
-						history_.emplace_back("&&Rneed 2 or more ids for connections - skipping\n");
-						continue;
-					}
+						for (std::string line; std::getline(content, line);)
+						{
+							ss << "saving " << line << '\n';
+						}
 
-					split.pop_back();
-					connectionsVec.push_back(std::move(connections));
+						ss << "graph saved to file '" << path << "'!\n";
+						job.print(ss.str());
+					});
+			}, true);
+		callbacks_.try_emplace("exec", [this](const std::vector<std::string>& args)
+			{
+				const auto engine = engineFromString(args[0]);
 
-					try
-					{
-						splitNodes.push_back({ std::stof(split[0]), std::stof(split[1]), std::stof(split[2]), std::stoi(split[3]) });
-					}
-					catch (const std::exception& e)
-					{
-						history_.emplace_back("&&Rbad data - " + std::string(e.what()) + '\n');
-						return;
-					}
+				if (!engine)
+				{
+					print("&&Runknown parameter '" + args[0] + "'!");
+					return;
 				}
 
-				for (const auto& [x, y, id, isCollision] : splitNodes)
+				const auto targets = Graph::get().targetIds();
+				if (!targets)
 				{
-					if (Graph::get().addNode({ x,y }, id, isCollision))
-					{
-						ss << std::format("adding node at ({},{}) with id {} and collision {}\n", x, y, id, isCollision ? "on" : "off");
-					}
-					else
-					{
-						ss << std::format("node with id {} already exists - skipping\n", id);
-					}
+					print("&&Gno path found");
+					return;
 				}
 
-				for (const auto& connection : connectionsVec)
-				{
-					for (int i = 1; i < connection.size(); i++)
+				const auto [startId, endId] = *targets;
+				const uint64_t version{ Graph::get().version() };
+				const auto report = [this, startId, endId, engine = *engine](const std::shared_ptr<const PathResult>& result, const float seconds, const bool cached)
 					{
-						if (Graph::get().addIdConnection({ connection[0], connection[i] }))
+						Graph::get().showSearchResult(startId, endId, engine, result);
+
+						if (!result)
 						{
-							ss << "adding connection " << connection[0] << "<->" << connection[i] << '\n';
+							print("&&Rgraph is not an 8-connected uniform grid, use 'exec astar'");
+						}
+						else if (result->found)
+						{
+							print(std::format("&&Gpath found, length: {}, execution time: {}s, nodes expanded: {}{}, cache hit rate: {:.1f}%",
+								result->length, seconds, result->expanded, cached ? " (cached)" : "", Graph::get().pathCache().hitRate() * 100.f));
+
+							if constexpr (SearchStats::enabled)
+							{
+								print("&&G" + result->stats.describe());
+							}
 						}
 						else
 						{
-							ss << std::format("connection {}<->{} already exists - skipping\n", connection[0], connection[i]);
+							print("&&Gno path found");
 						}
-					}
+					};
+
+				if (const auto cached = Graph::get().pathCache().find(startId, endId, *engine, version))
+				{
+					report(cached, 0.f, true);
+					return;
 				}
 
-				Graph::get().resetIndex();
+				//the search runs on a copy, its result is dropped if the graph was edited before it finished
+				auto snapshot = Graph::get().searchSnapshot();
 
-				history_.emplace_back(ss.str());
+				JobSystem::get().submit("exec " + args[0], [this, snapshot, startId, endId, engine = *engine, version, report](JobContext& job)
+					{
+						sf::Clock clock;
+						const auto result = snapshot->findPath(startId, endId, engine);
+						const float seconds{ clock.getElapsedTime().asSeconds() };
+
+						job.then([this, result, seconds, version, report]
+							{
+								if (Graph::get().version() != version)
+								{
+									print("&&Rgraph changed during the search, result discarded");
+									return;
+								}
+
+								report(result, seconds, false);
+							});
+					});
 			}, true);
-		callbacks_.emplace_back("save", [this](const std::vector<std::string>& args)
+		callbacks_.try_emplace("animate", [this](const std::vector<std::string>& args)
 			{
-				std::fstream file;
-				file.open(args[0], std::ios::out);
-				const std::vector<Node>& nodesRef = Graph::get().nodesCRef();
+				const auto expansions = utils::parseUnsigned(args[0]);
+				if (!expansions || *expansions == 0)
+				{
+					print("&&Rcan't convert '" + args[0] + "' to a number of expansions per frame!");
+					return;
+				}
+
+				if (!Graph::get().startLiveSearch(*expansions))
+				{
+					print("&&Rstart and end nodes need to be set first!");
+					return;
+				}
+
+				print(std::format("&&Ganimating search, {} expansions per frame", *expansions));
+			}, true);
+		callbacks_.try_emplace("run", [this](const std::vector<std::string>& args)
+			{
+				std::ifstream file(args[0]);
 
 				if (!file.is_open())
 				{
-					history_.emplace_back("&&Rcan't open file '" + args[0] + "'!\n");
+					print("&&Rcan't open file '" + args[0] + "'!");
 					return;
 				}
-				else if (nodesRef.empty())
+
+				if (quiet_ >= maxScriptDepth_)
 				{
-					file.close();
-					history_.emplace_back("&&Rno nodes to save!\n");
-					std::filesystem::remove(std::filesystem::path(args[0]));
+					print("&&Rscripts are nested too deep!");
 					return;
 				}
-				
-				std::stringstream ss;
-				ss << "&&G";
 
-				for (const Node& node : nodesRef)
+				const std::string_view outerFile{ scriptFile_ };
+				const size_t outerLine{ scriptLine_ };
+				if (quiet_ == 0)
+				{
+					scriptErrors_ = 0;
+				}
+				size_t commands{};
+				sf::Clock clock;
+
+				//every command finishes, background jobs included, before the next line runs
+				++quiet_;
+				scriptFile_ = args[0];
+				scriptLine_ = 0;
+				for (std::string line; std::getline(file, line);)
 				{
-					std::string connections;
+					++scriptLine_;
+					const size_t first{ line.find_first_not_of(" \t\r") };
+					if (first == std::string::npos || line[first] == '#') continue;
 
-					connections += (std::to_string(node.id()) + ':');
+					executeCommand(line);
+					JobSystem::get().finish();
+					++commands;
+				}
+				--quiet_;
+				scriptFile_ = outerFile;
+				scriptLine_ = outerLine;
 
-					for (const Node* conn : node.connections_)
-					{
-						connections += (std::to_string(conn->id()) + ':');
-					}
-					connections.erase(connections.end() - 1);
+				//a nested script's errors are already part of the outer one's
+				if (quiet_ > 0) return;
 
-					file << std::format("{},{},{},{},{}\n", node.pos().x, node.pos().y, node.id(), static_cast<int>(node.isCollision()), connections);
+				const size_t errors{ scriptErrors_ };
+				if (errors > maxScriptErrors_)
+				{
+					print(std::format("&&R{} more errors not shown", errors - maxScriptErrors_));
+				}
 
-					ss << std::format("saving {},{},{},{},{}\n", node.pos().x, node.pos().y, node.id(), static_cast<int>(node.isCollision()), connections);
+				print(std::format("{}ran {} commands from '{}' in {}s, {} errors", errors ? "&&R" : "&&G", commands, args[0], clock.getElapsedTime().asSeconds(), errors));
+			}, true);
+		callbacks_.try_emplace("serve", [this](const std::vector<std::string>& args)
+			{
+				if (args.size() > 2)
+				{
+					print("&&Rneed 'serve <socket path> [threads]'!");
+					return;
 				}
 
-				ss << "graph saved to file '" << args[0] << "'!\n";
-				history_.emplace_back(ss.str());
+				const auto threads = args.size() == 2 ? utils::parseUnsigned(args[1]) : std::optional<uint64_t>(std::max(std::thread::hardware_concurrency(), 1u));
+				if (!threads || *threads == 0)
+				{
+					print("&&Rcan't convert '" + args.back() + "' to a number of threads!");
+					return;
+				}
+
+				//the server answers from its own copy, so the graph stays editable while it runs, and from its own thread,
+				//so other jobs don't queue up behind it
+				auto server = std::make_shared<QueryServer>(Graph::get(), static_cast<unsigned int>(*threads));
+				JobSystem::get().spawn("serve " + args[0], [server, path = args[0]](JobContext& job) { server->serve(path, job); });
 			}, true);
-		callbacks_.emplace_back("exec", [this](const std::vector<std::string>& args)
+		callbacks_.try_emplace("bench", [this](const std::vector<std::string>& args)
 			{
-				if (args[0] == "astar")
+				if (args.size() < 2 || args.size() > 4)
+				{
+					print("&&Rneed 'bench <engine> <queries> [seed] [json file]'!");
+					return;
+				}
+
+				const auto engine = engineFromString(args[0]);
+				if (!engine)
+				{
+					print("&&Runknown parameter '" + args[0] + "'!");
+					return;
+				}
+
+				const auto count = utils::parseUnsigned(args[1]);
+				if (!count || *count == 0)
+				{
+					print("&&Rcan't convert '" + args[1] + "' to a number of queries!");
+					return;
+				}
+
+				if (*count > maxQueries_)
+				{
+					print(std::format("&&Rat most {} queries at a time!", maxQueries_));
+					return;
+				}
+
+				//a third argument that isn't a number is the json file
+				std::optional<uint64_t> seed{ args.size() > 2 ? utils::parseUnsigned(args[2]) : std::optional<uint64_t>(std::random_device{}()) };
+				std::string jsonPath{ args.size() == 4 ? args[3] : "" };
+				if (!seed && args.size() == 3)
+				{
+					seed = std::random_device{}();
+					jsonPath = args[2];
+				}
+				else if (!seed)
 				{
-					auto result = Graph::get().executeAStar();
+					print("&&Rcan't convert '" + args[2] + "' to a seed!");
+					return;
+				}
 
-					//return;
+				const auto queries = Graph::get().randomQueries(*count, *seed);
+				if (queries.empty())
+				{
+					print("&&Rthe graph needs at least two walkable nodes!");
+					return;
+				}
+
+				auto snapshot = Graph::get().searchSnapshot();
 
-					if (result)
+				JobSystem::get().submit("bench " + args[0], [snapshot, queries, engine = *engine, seed = *seed, jsonPath](JobContext& job)
 					{
-						history_.emplace_back("&&Gpath found, execution time: " + *result + "s");
+						using clock = std::chrono::steady_clock;
+
+						//one untimed query builds the jump point grid, the cache is emptied so every query really searches
+						if (!snapshot->findPath(queries.front().first, queries.front().second, engine))
+						{
+							job.print("&&Rgraph is not an 8-connected uniform grid, use 'bench astar'");
+							return;
+						}
+
+						std::vector<float> latencies;
+						latencies.reserve(queries.size());
+						size_t expanded{};
+						size_t found{};
+						SearchStats stats;
+						clock::duration total{};
+
+						for (const auto& [start, end] : queries)
+						{
+							if (job.stopRequested()) return;
+
+							snapshot->pathCache().clear();
+							const auto begin = clock::now();
+							const auto result = snapshot->findPath(start, end, engine);
+							const auto elapsed = clock::now() - begin;
+
+							total += elapsed;
+							latencies.push_back(std::chrono::duration<float, std::micro>(elapsed).count());
+							expanded += result->expanded;
+							found += result->found;
+							stats += result->stats;
+						}
+
+						std::ranges::sort(latencies);
+						const float seconds{ std::chrono::duration<float>(total).count() };
+						const float throughput{ seconds > 0.f ? latencies.size() / seconds : 0.f };
+						const float averageExpanded{ static_cast<float>(expanded) / latencies.size() };
+
+						job.print(std::format("&&G{} queries with {} on {} nodes, seed {}, {} found\n"
+							"{:.0f} queries/s, latency min {:.1f}us p50 {:.1f}us p90 {:.1f}us p99 {:.1f}us max {:.1f}us, {:.1f} nodes expanded on average",
+							latencies.size(), engineName(engine), snapshot->nodesCRef().size(), seed, found, throughput,
+							latencies.front(), utils::percentile(latencies, 0.5f), utils::percentile(latencies, 0.9f), utils::percentile(latencies, 0.99f), latencies.back(), averageExpanded));
+
+						if constexpr (SearchStats::enabled)
+						{
+							job.print("&&Gtotal " + stats.describe());
+						}
+
+						if (jsonPath.empty()) return;
+
+						std::ofstream file(jsonPath);
+						if (!file.is_open())
+						{
+							job.print("&&Rcan't open file '" + jsonPath + "'!");
+							return;
+						}
+
+						file << std::format("{{\n  \"build\": \"{} {}\",\n  \"engine\": \"{}\",\n  \"nodes\": {},\n  \"connections\": {},\n  \"queries\": {},\n  \"seed\": {},\n  \"found\": {},\n"
+							"  \"seconds\": {},\n  \"queries_per_second\": {},\n  \"latency_us\": {{ \"min\": {}, \"p50\": {}, \"p90\": {}, \"p99\": {}, \"max\": {} }},\n  \"average_expanded\": {}{}\n}}\n",
+							__DATE__, __TIME__, engineName(engine), snapshot->nodesCRef().size(), snapshot->connectionsCRef().size(), latencies.size(), seed, found,
+							seconds, throughput, latencies.front(), utils::percentile(latencies, 0.5f), utils::percentile(latencies, 0.9f), utils::percentile(latencies, 0.99f), latencies.back(), averageExpanded,
+							!SearchStats::enabled ? "" : std::format(",\n  \"search_stats\": {{ \"relaxed\": {}, \"pushes\": {}, \"decrease_keys\": {}, \"pops\": {}, \"peak_open\": {}, \"reconstruction_us\": {} }}",
+								stats.relaxed, stats.pushes, stats.decreaseKeys, stats.pops, stats.peakOpen, stats.reconstructionMicroseconds));
+						job.print("&&Gresults written to file '" + jsonPath + "'");
+					});
+			}, true);
+		callbacks_.try_emplace("profile", [this](const std::vector<std::string>& args)
+			{
+				Profiler& profiler = Profiler::get();
+
+				if (args[0] == "start" && args.size() == 1)
+				{
+					if (profiler.start())
+					{
+						print("&&Gprofiling started, 'profile stop <file>' writes a Chrome trace");
 					}
 					else
 					{
-						history_.emplace_back("&&Gno path found");
+						print("&&Ralready profiling!");
 					}
 				}
+				else if (args[0] == "stop" && args.size() == 2)
+				{
+					if (!profiler.recording())
+					{
+						print("&&Rnot profiling, use 'profile start' first!");
+						return;
+					}
+
+					profiler.stop(args[1], [this](const std::string& line) { print(line); });
+				}
 				else
 				{
-					history_.emplace_back("&&Runknown parameter '" + args[0] + "'!");
+					print("&&Runknown parameter '" + args[0] + "', use 'profile start|stop <file>'!");
 				}
 			}, true);
-		callbacks_.emplace_back("save", [this](const std::vector<std::string>& args)
+		callbacks_.try_emplace("cache", [this](const std::vector<std::string>& args)
 			{
-				std::fstream file;
-				file.open(args[0], std::ios::out);
-				const std::vector<Node>& nodesRef = Graph::get().nodesCRef();
+				PathCache& cache = Graph::get().pathCache();
 
-				if (!file.is_open())
+				if (args[0] == "stats")
 				{
-					history_.emplace_back("&&Rcan't open file '" + args[0] + "'!\n");
-					return;
+					print(std::format("&&G{}/{} cached paths, {} hits, {} misses, hit rate: {:.1f}%",
+						cache.size(), cache.capacity(), cache.hits(), cache.misses(), cache.hitRate() * 100.f));
 				}
-				else if (nodesRef.empty())
+				else if (args[0] == "clear")
 				{
-					file.close();
-					history_.emplace_back("&&Rno nodes to save!\n");
-					std::filesystem::remove(std::filesystem::path(args[0]));
-					return;
+					cache.clear();
+					print("&&Gpath cache cleared");
+				}
+				else if (args[0] == "size" && args.size() == 2)
+				{
+					try
+					{
+						cache.setCapacity(std::stoul(args[1]));
+						print("&&Gpath cache capacity set to " + args[1]);
+					}
+					catch (const std::exception& e)
+					{
+						print("&&Rcan't convert '" + args[1] + "' to a number: " + e.what());
+					}
+				}
+				else
+				{
+					print("&&Runknown parameter '" + args[0] + "', use 'cache stats|clear|size <n>'!");
 				}
+			}, true);
+		callbacks_.try_emplace("journal", [this](const std::vector<std::string>& args)
+			{
+				Journal& journal = Journal::get();
 
-				std::stringstream ss;
-				ss << "&&G";
+				if (args[0] == "open")
+				{
+					if (args.size() != 2)
+					{
+						print("&&Rincorrect number of arguments, need 'journal open <file>'!");
+						return;
+					}
+
+					//an existing snapshot or journal is recovered, otherwise the current graph becomes the first snapshot
+					const bool existing{ std::filesystem::exists(args[1]) || std::filesystem::exists(args[1] + ".journal") };
+					const size_t replayed{ existing ? journal.recover(args[1]) : 0 };
+
+					if (!journal.open(args[1]))
+					{
+						print("&&Rcan't open journal '" + args[1] + ".journal'!");
+						return;
+					}
 
-				for (const Node& node : nodesRef)
+					//either way a fresh snapshot is written, after a recovery it replaces the replayed journals
+					journal.compact();
+					if (existing)
+					{
+						print(std::format("&&Grecovered '{}' and replayed {} journal entries", args[1], replayed));
+					}
+					else
+					{
+						print("&&Gjournaling edits to '" + args[1] + ".journal'");
+					}
+				}
+				else if (!journal.isOpen())
+				{
+					print("&&Rno journal open, use 'journal open <file>'!");
+				}
+				else if (args[0] == "flush")
+				{
+					journal.flush();
+					print("&&Gjournal flushed");
+				}
+				else if (args[0] == "compact")
+				{
+					if (journal.compact())
+					{
+						print("&&Gcompacting journal in the background");
+					}
+					else
+					{
+						print("&&Rjournal compaction already in progress or unfinished!");
+					}
+				}
+				else if (args[0] == "close")
 				{
-					std::string connections;
+					journal.close();
+					print("&&Gjournal closed");
+				}
+				else
+				{
+					print("&&Runknown parameter '" + args[0] + "'!");
+				}
+			}, true);
+		callbacks_.try_emplace("generate", [this](const std::vector<std::string>& args)
+			{
+				if (args[0] == "grid" || args[0] == "maze")
+				{
+					//'generate grid <width> <height> [obstacle%] [seed]' or 'generate maze <width> <height> [seed]'
+					const bool grid{ args[0] == "grid" };
+					const size_t maxArgs{ grid ? 5u : 4u };
+					if (args.size() < 3 || args.size() > maxArgs)
+					{
+						print(grid ? "&&Rneed 'generate grid <width> <height> [obstacle%] [seed]'!" : "&&Rneed 'generate maze <width> <height> [seed]'!");
+						return;
+					}
 
-					connections += (std::to_string(node.id()) + ':');
+					const auto width = utils::parseUnsigned(args[1]);
+					const auto height = utils::parseUnsigned(args[2]);
+					float obstacles{};
+					if (!width || !height || *width * *height > std::numeric_limits<int>::max())
+					{
+						print("&&Rinvalid lattice size '" + args[1] + "x" + args[2] + "'!");
+						return;
+					}
 
-					for (const Node* conn : node.connections_)
+					if (grid && args.size() >= 4)
 					{
-						connections += (std::to_string(conn->id()) + ':');
+						try
+						{
+							obstacles = std::stof(args[3]) / 100.f;
+						}
+						catch (const std::exception& e)
+						{
+							print("&&Rcan't convert '" + args[3] + "' to a number: " + e.what());
+							return;
+						}
+					}
+
+					const auto seed = args.size() == maxArgs ? utils::parseUnsigned(args.back()) : std::optional<uint64_t>(std::random_device{}());
+					if (!seed)
+					{
+						print("&&Rcan't convert '" + args.back() + "' to a seed!");
+						return;
 					}
-					connections.erase(connections.end() - 1);
 
-					file << std::format("{},{},{},{},{}\n", node.pos().x, node.pos().y, node.id(), static_cast<int>(node.isCollision()), connections);
+					JobSystem::get().submit("generate " + args[0], [this, grid, width = *width, height = *height, obstacles, seed = *seed](JobContext& job)
+						{
+							sf::Clock clock;
+							auto graph = std::make_shared<Graph>();
+							graph->seed(seed);
+							const int placed{ grid ? graph->generateGrid(width, height, obstacles) : graph->generateMaze(width, height) };
+							const std::string message{ std::format("&&Ggenerated {} with {} nodes and {} connections in {}s",
+								grid ? "grid" : "maze", placed, graph->connectionsCRef().size(), clock.getElapsedTime().asSeconds()) };
+
+							job.then([this, graph, message]
+								{
+									Graph::get().adopt(*graph);
+									print(message);
+								});
+						});
+					return;
+				}
 
-					ss << std::format("saving {},{},{},{},{}\n", node.pos().x, node.pos().y, node.id(), static_cast<int>(node.isCollision()), connections);
+				//'generate <nodes> <chance> <radius> [seed]' or 'generate knn|disk|delaunay <nodes> [k|range] <radius> [seed]'
+				std::optional<GeometricGraph> kind;
+				size_t expected{ 3 };
+				if (args[0] == "knn" || args[0] == "disk")
+				{
+					kind = args[0] == "knn" ? GeometricGraph::KNearest : GeometricGraph::Radius;
+					expected = 4;
+				}
+				else if (args[0] == "delaunay")
+				{
+					kind = GeometricGraph::Delaunay;
+					expected = 3;
 				}
 
-				ss << "graph saved to file '" << args[0] << "'!\n";
-				history_.emplace_back(ss.str());
-			}, true);
-		callbacks_.emplace_back("generate", [this](const std::vector<std::string>& args)
-			{
-				if (args.size() != 3)
+				if (args.size() != expected && args.size() != expected + 1)
 				{
-					history_.emplace_back("&&Rincorrect number of arguments, need 3!");
+					print(std::format("&&Rincorrect number of arguments, need {} and an optional seed!", expected));
 					return;
 				}
 
 				std::vector<float> nodesConnectionsCount;
 
-				for (const std::string& arg : args)
+				for (size_t i = kind ? 1 : 0; i < expected; i++)
 				{
 					try
 					{
-						for (const std::string& arg : args)
-						{
-							nodesConnectionsCount.push_back(std::stof(arg));
-						}
+						nodesConnectionsCount.push_back(std::stof(args[i]));
 					}
 					catch (const std::exception& e)
 					{
-						history_.emplace_back("&&Rcan't convert '" + arg + "' to a number: " + e.what());
+						print("&&Rcan't convert '" + args[i] + "' to a number: " + e.what());
 						return;
 					}
 				}
 
-				Graph::get().generateRandomGraph(nodesConnectionsCount[0], nodesConnectionsCount[1], nodesConnectionsCount[2]);
+				const auto seed = args.size() > expected ? utils::parseUnsigned(args.back()) : std::optional<uint64_t>(std::random_device{}());
+				if (!seed)
+				{
+					print("&&Rcan't convert '" + args.back() + "' to a seed!");
+					return;
+				}
+
+				JobSystem::get().submit("generate " + args[0], [this, kind, nodesConnectionsCount, seed = *seed](JobContext& job)
+					{
+						auto graph = std::make_shared<Graph>();
+						graph->seed(seed);
+
+						int placed;
+						if (!kind)
+						{
+							placed = graph->generateRandomGraph(nodesConnectionsCount[0], nodesConnectionsCount[1], nodesConnectionsCount[2]);
+						}
+						else if (*kind == GeometricGraph::Delaunay)
+						{
+							placed = graph->generateGeometricGraph(*kind, nodesConnectionsCount[0], 0.f, nodesConnectionsCount[1]);
+						}
+						else
+						{
+							placed = graph->generateGeometricGraph(*kind, nodesConnectionsCount[0], nodesConnectionsCount[1], nodesConnectionsCount[2]);
+						}
+
+						if (placed < static_cast<int>(nodesConnectionsCount[0]))
+						{
+							job.print(std::format("&&Ronly {} of {} nodes fit within radius {} at the minimum spacing", placed, nodesConnectionsCount[0], nodesConnectionsCount.back()));
+						}
+
+						const std::string message{ std::format("&&Ggenerated graph with {} nodes and {} connections", placed, graph->connectionsCRef().size()) };
+						job.then([this, graph, message]
+							{
+								Graph::get().adopt(*graph);
+								print(message);
+							});
+					});
+			}, true);
+		callbacks_.try_emplace("queries", [this](const std::vector<std::string>& args)
+			{
+				//'queries <count> <file> [seed]' writes random start/end pairs of the current graph, one per line
+				if (args.size() != 2 && args.size() != 3)
+				{
+					print("&&Rincorrect number of arguments, need 'queries <count> <file> [seed]'!");
+					return;
+				}
+
+				const auto count = utils::parseUnsigned(args[0]);
+				const auto seed = args.size() == 3 ? utils::parseUnsigned(args[2]) : std::optional<uint64_t>(std::random_device{}());
+				if (!count || !seed)
+				{
+					print("&&Rcan't convert '" + (count ? args[2] : args[0]) + "' to a number!");
+					return;
+				}
+
+				if (*count == 0 || *count > maxQueries_)
+				{
+					print(std::format("&&Rneed between 1 and {} queries!", maxQueries_));
+					return;
+				}
+
+				const std::vector<std::pair<int, int>> queries{ Graph::get().randomQueries(*count, *seed) };
+				if (queries.empty())
+				{
+					print("&&Rneed at least 2 walkable nodes to generate queries!");
+					return;
+				}
+
+				std::ofstream file(args[1]);
+				if (!file.is_open())
+				{
+					print("&&Rcan't open file '" + args[1] + "'!");
+					return;
+				}
+
+				for (const auto& [start, end] : queries)
+				{
+					file << start << ' ' << end << '\n';
+				}
 
-				history_.emplace_back("&&Ggenerated graph");
+				print(std::format("&&Gwrote {} queries with seed {} to file '{}'", queries.size(), *seed, args[1]));
 			}, true);
-		callbacks_.emplace_back("generatetimeout", [this](const std::vector<std::string>& args)
+		callbacks_.try_emplace("generatetimeout", [this](const std::vector<std::string>& args)
 			{
-				if (args.size() != 4)
+				if (args.size() != 4 && args.size() != 5)
 				{
-					history_.emplace_back("&&Rincorrect number of arguments, need 4!");
+					print("&&Rincorrect number of arguments, need 4 and an optional seed!");
 					return;
 				}
 
 				std::vector<float> nodesConnectionsCount;
 
-				for (const std::string& arg : args)
+				for (size_t i = 0; i < 4; i++)
 				{
 					try
 					{
-						for (const std::string& arg : args)
-						{
-							nodesConnectionsCount.push_back(std::stof(arg));
-						}
+						nodesConnectionsCount.push_back(std::stof(args[i]));
 					}
 					catch (const std::exception& e)
 					{
-						history_.emplace_back("&&Rcan't convert '" + arg + "' to a number: " + e.what());
+						print("&&Rcan't convert '" + args[i] + "' to a number: " + e.what());
 						return;
 					}
 				}
 
-				float bestSoFar{};
-				float stop{ nodesConnectionsCount[3] };
-				sf::Clock stopTimer;
-				for (long long i = 0;; i++)
+				//iteration i always generates from stream i of the seed, whichever thread picks it up
+				const auto seed = args.size() == 5 ? utils::parseUnsigned(args[4]) : std::optional<uint64_t>(std::random_device{}());
+				if (!seed)
 				{
-					Graph::get().generateRandomGraph(nodesConnectionsCount[0], nodesConnectionsCount[1], nodesConnectionsCount[2]);
-					if (Graph::get().executeAStar() && Graph::get().pathLength() > bestSoFar)
-					{
-#ifdef _DEBUG
-						std::cout << "graphs generated: " << i << '\n';
-						std::cout << "path found! path length: " << Graph::get().pathLength() << '\n';
-						std::cout << "saving to bestgraph.txt\n";
-#endif
-						bestSoFar = Graph::get().pathLength();
-						std::string command{ "save bestgraph.txt" };
-						Console::get().executeCommand(command);
-						stop = nodesConnectionsCount[3];
-					}
-					history_.clear();
-					stop -= stopTimer.restart().asSeconds();
+					print("&&Rcan't convert '" + args[4] + "' to a seed!");
+					return;
+				}
 
-					if (stop <= 0.f)
+				JobSystem::get().submit("generatetimeout", [nodesConnectionsCount, seed = *seed](JobContext& job)
 					{
-						return;
-					}
-				}
-			}, true);
-		font_.loadFromFile("mono.ttf");
-		text_.setFont(font_);
-		text_.setCharacterSize(16);
-		history_.reserve(100);
-		carriage_.setFillColor(sf::Color::White);
-		carriage_.setSize({ 1, 16 });
-	}
+						//every worker owns two graphs and swaps them when it beats the shared best, the search stops once
+						//nobody has improved on it for the timeout or the job is cancelled
+						struct Worker
+						{
+							std::unique_ptr<Graph> current{ std::make_unique<Graph>() };
+							std::unique_ptr<Graph> best{ std::make_unique<Graph>() };
+							float bestLength{};
+							uint64_t bestSeed{};
+							long long evaluated{};
+						};
+
+						using clock = std::chrono::steady_clock;
+						const auto timeout = std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(nodesConnectionsCount[3]));
+						const unsigned int threadCount{ std::max(std::thread::hardware_concurrency(), 1u) };
+						std::vector<Worker> workers(threadCount);
+						std::atomic<float> bestSoFar{};
+						std::atomic<uint64_t> nextIteration{};
+						std::atomic<clock::rep> lastImprovement{ clock::now().time_since_epoch().count() };
+						const auto started = clock::now();
 
-	void Console::handleInput(const sf::Keyboard::Key key)
-	{
-		if (key == sf::Keyboard::Tilde && key != '6')
-		{
-			consoleOpen_ = !consoleOpen_;
-		}
-		else if (key == 13 && !currentText_.empty())
-		{
-			executeCommand(currentText_);
-		}
-		else if (key == sf::Keyboard::Left)
-		{
-			moveCarriage(true);
-		}
-		else if (key == sf::Keyboard::Right)
-		{
-			moveCarriage(false);
-		}
+						{
+							std::vector<std::jthread> threads;
+							for (Worker& worker : workers)
+							{
+								threads.emplace_back([&]
+									{
+										while (!job.stopRequested() && clock::now() - clock::time_point(clock::duration(lastImprovement.load())) < timeout)
+										{
+											Graph& graph = *worker.current;
+											const uint64_t graphSeed{ utils::streamSeed(seed, nextIteration++) };
+											graph.seed(graphSeed);
+											graph.generateRandomGraph(nodesConnectionsCount[0], nodesConnectionsCount[1], nodesConnectionsCount[2]);
+											++worker.evaluated;
+
+											const std::vector<Node>& nodes = graph.nodesCRef();
+											if (nodes.size() < 2) continue;
+
+											const auto result = graph.findPath(nodes.front().id(), nodes.back().id(), SearchEngine::AStar);
+											if (!result || !result->found) continue;
+
+											float seen{ bestSoFar.load() };
+											while (result->length > seen && !bestSoFar.compare_exchange_weak(seen, result->length));
+
+											if (result->length > seen)
+											{
+												lastImprovement = clock::now().time_since_epoch().count();
+												worker.bestLength = result->length;
+												worker.bestSeed = graphSeed;
+												std::swap(worker.current, worker.best);
+												job.print(std::format("&&Gnew best path length: {}", result->length));
+											}
+										}
+									});
+							}
+						}
 
-#ifdef _DEBUG
-		std::cout << "current text size: " << currentText_.size() << '\n';
-		std::cout << "keycode: " << key << '\n';
-#endif
-	}
+						long long evaluated{};
+						const Worker* winner{};
+						for (const Worker& worker : workers)
+						{
+							evaluated += worker.evaluated;
+							if (worker.bestLength > 0.f && (!winner || worker.bestLength > winner->bestLength))
+							{
+								winner = &worker;
+							}
+						}
 
-	void Console::toggle()
-	{
-		consoleOpen_ = !consoleOpen_;
+						const float seconds{ std::chrono::duration<float>(clock::now() - started).count() };
+						job.print(std::format("&&Gevaluated {} graphs in {:.2f}s on {} threads ({:.0f} graphs/s), seed {}{}",
+							evaluated, seconds, threadCount, evaluated / seconds, seed, job.stopRequested() ? ", cancelled" : ""));
+
+						if (!winner)
+						{
+							job.print("&&Rno generated graph had a path between its first and last node!");
+							return;
+						}
+
+						std::ofstream file("bestgraph.txt");
+						if (!file.is_open())
+						{
+							job.print("&&Rcan't open file 'bestgraph.txt'!");
+							return;
+						}
+
+						winner->best->writeSnapshot(file);
+						job.print(std::format("&&Gbest path length: {} (graph seed {}), graph saved to file 'bestgraph.txt', use 'load bestgraph.txt' to view it",
+							winner->bestLength, winner->bestSeed));
+					});
+			}, true);
 	}
 
-	void Console::addChar(const char c)
+	//tokens are views into the command, they are only copied into the argument strings of the current nesting
+	//level, so a command run from inside another one (a script) doesn't overwrite the arguments of its caller
+	void Console::executeCommand(const std::string_view command)
 	{
-		if (c != 8 && c != '`' && c != 13)
-		{
-			currentText_ += c;
-			moveCarriage(false);
-		}
-		else if (c == 8)
+		constexpr std::string_view separators{ " \t\r" };
+
+		if (argumentPool_.size() <= depth_)
 		{
-			if (!currentText_.empty() && carriagePos_ > 1)
-			{
-				moveCarriage(true);
-				currentText_.pop_back();
-			}
+			argumentPool_.emplace_back();
 		}
-	}
 
-	bool Console::isOpen() const
-	{
-		return consoleOpen_;
-	}
+		std::vector<std::string>& args = argumentPool_[depth_];
+		args.clear();
 
-	void Console::executeCommand(std::string& command)
-	{
-		if (command[0] == ' ')
+		std::string_view name;
+		size_t lineEnd{};
+		for (size_t begin = command.find_first_not_of(separators); begin != std::string_view::npos; begin = command.find_first_not_of(separators, lineEnd))
 		{
-			auto found_l = std::ranges::find_if(command, [](const char c) { return c != ' '; });
+			lineEnd = std::min(command.find_first_of(separators, begin), command.size());
+			const std::string_view token{ command.substr(begin, lineEnd - begin) };
 
-			if (found_l != command.end())
+			if (name.empty())
 			{
-				command.erase(command.begin(), found_l);
+				name = token;
 			}
-		}
-
-		if (command.back() == ' ')
-		{
-			for (int i = command.size() - 1; i >= 0; i--)
+			else
 			{
-				if (command[i] != ' ')
-				{
-					command.erase(command.begin() + i + 1, command.end());
-					break;
-				}
+				args.emplace_back(token);
 			}
 		}
 
-		std::vector<std::string> split;
-		split.reserve(2);
+		if (name.empty()) return;
 
-		if (std::ranges::count(command, ' ') > 0)
+		const auto found = callbacks_.find(name);
+		if (found == callbacks_.end())
 		{
-			size_t pos = 0;
-			while ((pos = command.find(' ')) != std::string::npos)
-			{
-				split.push_back(command.substr(0, pos));
-				command.erase(0, pos + 1);
-			}
-			split.push_back(command);
+			print(std::format("&&R{} - unknown command!", name));
+			return;
 		}
-		else
+
+		const auto& [callback, needsArgs] = found->second;
+		if (needsArgs && args.empty())
 		{
-			split.push_back(command);
+			print(std::format("&&R{} - command expects arguments!", name));
+			return;
 		}
 
-
-		if (const auto& pos = std::ranges::find_if(callbacks_, [&command = split[0]](const Command& cmd) { return std::get<0>(cmd) == command; }); pos != callbacks_.end())
+		if (echo_)
 		{
-			if (!std::get<2>(*pos))
-			{
-				history_.push_back(split[0]);
-				std::get<1>(*pos)({});
-			}
-			else
-			{
-				if (split.size() < 2)
-				{
-					history_.push_back("&&R" + split[0] + " - command expects arguments!");
+			const size_t nameBegin{ static_cast<size_t>(name.data() - command.data()) };
+			print(std::string(needsArgs ? command.substr(nameBegin, lineEnd - nameBegin) : name));
+		}
 
-					if (history_.size() >= 40)
-					{
-						history_.erase(history_.begin());
-					}
-				}
-				else
-				{
-					std::stringstream ss;
-					ss << split[0] << ' ';
-					for (int i = 1; i < split.size(); i++)
-					{
-						ss << split[i] << ' ';
-					}
+		++depth_;
+		callback(args);
+		--depth_;
+	}
 
-					history_.push_back(ss.str());
-					std::get<1>(*pos)(std::vector(split.begin() + 1, split.end()));
-				}
-			}
+	//the colour prefix is resolved once here, the output only sees the text and how severe it is
+	void Console::print(const std::string& entry)
+	{
+		std::string_view text{ entry };
+		Severity severity{ Severity::Plain };
+
+		if (text.starts_with("&&R"))
+		{
+			severity = Severity::Error;
+			text.remove_prefix(3);
 		}
-		else if (!currentText_.empty())
+		else if (text.starts_with("&&G"))
 		{
-			history_.push_back("&&R" + split[0] + " - unknown command!");
-#ifdef _DEBUG
-			std::cout << "history size: " << history_.size() << '\n';
-			std::cout << "current text size: " << currentText_.size() << '\n';
-#endif
+			severity = Severity::Info;
+			text.remove_prefix(3);
+		}
 
-			if (history_.size() >= 40)
-			{
-				history_.erase(history_.begin());
-			}
+		//scripts only report errors, tagged with the line that caused them
+		if (quiet_ > 0)
+		{
+			if (severity != Severity::Error || scriptErrors_++ >= maxScriptErrors_) return;
+
+			output_(std::format("{}:{}: {}", scriptFile_, scriptLine_, text), severity);
+			return;
 		}
 
-		currentText_.clear();
-		carriagePos_ = 1;
-		carriage_.setPosition(4, carriage_.getPosition().y);
+		output_(text, severity);
 	}
 
-	void Console::resetCarriage(const sf::Vector2f& carriagePos)
+	void Console::addCommand(const std::string& name, Callback callback, const bool needsArgs)
 	{
-		carriage_.setPosition(carriagePos);
+		callbacks_.insert_or_assign(name, Command{ std::move(callback), needsArgs });
 	}
 
-	void Console::draw(sf::RenderTarget& rt)
+	void Console::setOutput(Output output)
 	{
-		if (consoleOpen_)
-		{
-			const auto& size = rt.getSize();
-
-			sf::RectangleShape rect(sf::Vector2f{ size });
-			rect.setFillColor(sf::Color(0, 0, 0, 220));
-			text_.setString(currentText_);
-			text_.setFillColor(sf::Color::White);
-			text_.setPosition(4, size.y - 22);
-			rt.draw(rect);
-			rt.draw(text_);
-
-			float textPos{ 40.f };
-			for (std::vector<std::string>::reverse_iterator rIter{ history_.rbegin() }; rIter != history_.rend(); ++rIter)
-			{
-				std::string cpy;
-				if (rIter->find("&&R") != std::string::npos)
-				{
-					text_.setFillColor(sf::Color::Red);
-					cpy = rIter->substr(3);
-				}
-				else if (rIter->find("&&G") != std::string::npos)
-				{
-					text_.setFillColor(sf::Color::Green);
-					cpy = rIter->substr(3);
-				}
-				else
-				{
-					text_.setFillColor(sf::Color::White);
-					cpy = *rIter;
-				}
-
-				const int newlines = std::count(cpy.begin(), cpy.end(), '\n');
-
-				if (newlines)
-				{
-					text_.setPosition(4, size.y - (textPos += (22 * (newlines))));
-				}
-				else
-				{
-					text_.setPosition(4, size.y - (textPos += 18));
-				}
-
-				text_.setString(cpy);
-				rt.draw(text_);
-			}
-
-			rt.draw(carriage_);
-		}
+		output_ = std::move(output);
 	}
 
-	void Console::moveCarriage(const bool left)
+	void Console::setEcho(const bool echo)
 	{
-		if (!currentText_.empty())
-		{
-			if (left && carriagePos_ > 1)
-			{
-				--carriagePos_;
-				carriage_.move(-carriageOffset_, 0);
-#ifdef _DEBUG
-				std::cout << "carriage x: " << carriage_.getPosition().x << ", pos: " << carriagePos_ << '\n';
-#endif
-			}
-			else if (!left && carriagePos_ <= currentText_.size())
-			{
-				++carriagePos_;
-				carriage_.move(carriageOffset_, 0);
-#ifdef _DEBUG
-				std::cout << "carriage x: " << carriage_.getPosition().x << ", pos: " << carriagePos_ << '\n';
-#endif
-			}
-		}
+		echo_ = echo;
 	}
 }
@@ -2,44 +2,60 @@
 
 #include "Graph.hpp"
 
-#include <SFML/Window/Keyboard.hpp>
 #include <string>
 #include <vector>
 #include <utility>
 #include <functional>
 #include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <deque>
+#include <cstdint>
 
 
-namespace
-{
-	using Command = std::tuple<std::string, std::function<void(const std::vector<std::string>&)>, bool>;
-}
-
 namespace astar
 {
+	enum class Severity : uint8_t
+	{
+		Plain,
+		Info, //&&G prefix
+		Error //&&R prefix
+	};
+
 	struct Console
 	{
+		using Output = std::function<void(std::string_view line, Severity severity)>;
+		using Callback = std::function<void(const std::vector<std::string>&)>;
+
 		void operator=(const Console&) = delete;
 		Console(const Console&) = delete;
 		static Console& get();
-		void handleInput(const sf::Keyboard::Key key);
-		void toggle();
-		void addChar(const char c);
-		bool isOpen() const;
-		void resetCarriage(const sf::Vector2f& carriagePos);
-		void draw(sf::RenderTarget& rt);
-		void moveCarriage(const bool left);
-		void executeCommand(std::string& command);
+		void executeCommand(const std::string_view command);
+		void addCommand(const std::string& name, Callback callback, const bool needsArgs); //for front ends with commands of their own
+		void print(const std::string& entry);
+		void setOutput(Output output); //stdout and stderr until a front end sets its own
+		void setEcho(const bool echo);
 	private:
+		using Command = std::pair<Callback, bool>; //callback, expects arguments
+
+		struct CommandHash
+		{
+			using is_transparent = void;
+			size_t operator()(const std::string_view name) const { return std::hash<std::string_view>{}(name); }
+		};
+
 		Console();
-		constexpr static int carriageOffset_{ 10 };
-		bool consoleOpen_;
-		size_t carriagePos_;
-		sf::RectangleShape carriage_;
-		std::string currentText_;
-		std::vector<Command> callbacks_;
-		std::vector<std::string> history_;
-		sf::Font font_;
-		sf::Text text_;
+		std::unordered_map<std::string, Command, CommandHash, std::equal_to<>> callbacks_;
+		std::deque<std::vector<std::string>> argumentPool_; //one argument list per nesting level, reused between commands
+		size_t depth_;
+		Output output_;
+		bool echo_; //print every executed command before its output
+		size_t quiet_; //nesting depth of running scripts, only errors are printed meanwhile
+		std::string_view scriptFile_;
+		size_t scriptLine_;
+		size_t scriptErrors_;
+		constexpr static size_t maxScriptErrors_{ 20 };
+		constexpr static size_t maxScriptDepth_{ 8 };
+		constexpr static uint64_t maxQueries_{ 10'000'000 }; //random queries of bench and queries, each keeps a pair and a latency in memory
 	};
 }
@@ -0,0 +1,171 @@
+#include "ConsoleWindow.hpp"
+#include "GraphRenderer.hpp"
+#include "Timer.hpp"
+#include <iostream>
+#include <algorithm>
+#include <ranges>
+
+
+namespace astar
+{
+	ConsoleWindow& ConsoleWindow::get()
+	{
+		static ConsoleWindow window;
+		return window;
+	}
+
+	ConsoleWindow::ConsoleWindow() : consoleOpen_{ false }, carriagePos_{ 1 }, historyHead_{}, historySize_{}
+	{
+		Console::get().setOutput([this](const std::string_view line, const Severity severity)
+			{
+				appendLines(line, severity == Severity::Error ? sf::Color::Red : severity == Severity::Info ? sf::Color::Green : sf::Color::White);
+			});
+		Console::get().addCommand("clear", [this](const std::vector<std::string>&) { historySize_ = 0; }, false);
+		Console::get().addCommand("distance", [](const std::vector<std::string>&) { GraphRenderer::get().toggleDrawDistance(); }, false);
+		font_.loadFromFile("mono.ttf");
+		text_.setFont(font_);
+		text_.setCharacterSize(16);
+		history_.assign(historyCapacity_, text_);
+		carriage_.setFillColor(sf::Color::White);
+		carriage_.setSize({ 1, 16 });
+	}
+
+	void ConsoleWindow::handleInput(const sf::Keyboard::Key key)
+	{
+		if (key == sf::Keyboard::Tilde && key != '6')
+		{
+			consoleOpen_ = !consoleOpen_;
+		}
+		else if (key == 13 && !currentText_.empty())
+		{
+			Console::get().executeCommand(currentText_);
+			currentText_.clear();
+			carriagePos_ = 1;
+			carriage_.setPosition(4, carriage_.getPosition().y);
+		}
+		else if (key == sf::Keyboard::Left)
+		{
+			moveCarriage(true);
+		}
+		else if (key == sf::Keyboard::Right)
+		{
+			moveCarriage(false);
+		}
+
+#ifdef _DEBUG
+		std::cout << "current text size: " << currentText_.size() << '\n';
+		std::cout << "keycode: " << key << '\n';
+#endif
+	}
+
+	void ConsoleWindow::toggle()
+	{
+		consoleOpen_ = !consoleOpen_;
+	}
+
+	void ConsoleWindow::addChar(const char c)
+	{
+		if (c != 8 && c != '`' && c != 13)
+		{
+			currentText_ += c;
+			moveCarriage(false);
+		}
+		else if (c == 8)
+		{
+			if (!currentText_.empty() && carriagePos_ > 1)
+			{
+				moveCarriage(true);
+				currentText_.pop_back();
+			}
+		}
+	}
+
+	bool ConsoleWindow::isOpen() const
+	{
+		return consoleOpen_;
+	}
+
+
+	void ConsoleWindow::appendLines(std::string_view text, const sf::Color color)
+	{
+		if (text.ends_with('\n'))
+		{
+			text.remove_suffix(1);
+		}
+
+		//only the last historyCapacity_ lines of a long entry survive, so the others are never converted
+		size_t begin{ text.size() };
+		for (size_t lines = 0; lines < historyCapacity_ && begin != std::string_view::npos; lines++)
+		{
+			begin = begin == 0 ? std::string_view::npos : text.rfind('\n', begin - 1);
+		}
+		begin = begin == std::string_view::npos ? 0 : begin + 1;
+
+		for (const auto line : std::views::split(text.substr(begin), '\n'))
+		{
+			sf::Text& slot = history_[historyHead_];
+			slot.setString(std::string(line.begin(), line.end()));
+			slot.setFillColor(color);
+			historyHead_ = (historyHead_ + 1) % historyCapacity_;
+			historySize_ = std::min(historySize_ + 1, historyCapacity_);
+		}
+	}
+
+	void ConsoleWindow::resetCarriage(const sf::Vector2f& carriagePos)
+	{
+		carriage_.setPosition(carriagePos);
+	}
+
+	void ConsoleWindow::draw(sf::RenderTarget& rt)
+	{
+		const Timer timer("ConsoleWindow::draw");
+
+		if (consoleOpen_)
+		{
+			const auto& size = rt.getSize();
+
+			sf::RectangleShape rect(sf::Vector2f{ size });
+			rect.setFillColor(sf::Color(0, 0, 0, 220));
+			text_.setString(currentText_);
+			text_.setFillColor(sf::Color::White);
+			text_.setPosition(4, size.y - 22);
+			rt.draw(rect);
+			rt.draw(text_);
+
+			//history lines keep their glyph geometry between frames, moving them only changes the transform
+			const float lineSpacing{ font_.getLineSpacing(text_.getCharacterSize()) };
+			float y{ size.y - 40.f };
+			for (size_t i = 0; i < historySize_ && y > 0.f; i++)
+			{
+				sf::Text& line = history_[(historyHead_ + historyCapacity_ - 1 - i) % historyCapacity_];
+				line.setPosition(4, y -= lineSpacing);
+				rt.draw(line);
+			}
+
+			rt.draw(carriage_);
+		}
+	}
+
+	void ConsoleWindow::moveCarriage(const bool left)
+	{
+		if (!currentText_.empty())
+		{
+			if (left && carriagePos_ > 1)
+			{
+				--carriagePos_;
+				carriage_.move(-carriageOffset_, 0);
+#ifdef _DEBUG
+				std::cout << "carriage x: " << carriage_.getPosition().x << ", pos: " << carriagePos_ << '\n';
+#endif
+			}
+			else if (!left && carriagePos_ <= currentText_.size())
+			{
+				++carriagePos_;
+				carriage_.move(carriageOffset_, 0);
+#ifdef _DEBUG
+				std::cout << "carriage x: " << carriage_.getPosition().x << ", pos: " << carriagePos_ << '\n';
+#endif
+			}
+		}
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Console.hpp"
+
+#include <SFML/Graphics.hpp>
+#include <SFML/Window/Keyboard.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace astar
+{
+	//On-screen front end of the Console, owns the input line and the history and adds the commands that need a window
+	class ConsoleWindow
+	{
+	public:
+		void operator=(const ConsoleWindow&) = delete;
+		ConsoleWindow(const ConsoleWindow&) = delete;
+		static ConsoleWindow& get();
+		void handleInput(const sf::Keyboard::Key key);
+		void toggle();
+		void addChar(const char c);
+		bool isOpen() const;
+		void resetCarriage(const sf::Vector2f& carriagePos);
+		void draw(sf::RenderTarget& rt);
+		void moveCarriage(const bool left);
+	private:
+		ConsoleWindow();
+		void appendLines(std::string_view text, const sf::Color color);
+		constexpr static int carriageOffset_{ 10 };
+		bool consoleOpen_;
+		size_t carriagePos_;
+		sf::RectangleShape carriage_;
+		std::string currentText_;
+		constexpr static size_t historyCapacity_{ 256 }; //lines, more than fit on any screen
+		std::vector<sf::Text> history_; //ring buffer of single coloured lines, historyHead_ is the next slot written
+		size_t historyHead_;
+		size_t historySize_;
+		sf::Font font_;
+		sf::Text text_;
+	};
+}
@@ -0,0 +1,300 @@
+#include "Geometry.hpp"
+#include "SpatialGrid.hpp"
+#include <array>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+	struct Point
+	{
+		double x;
+		double y;
+	};
+
+	//n[i] is the triangle across the edge opposite v[i], vertices are counter-clockwise, v[0] == -1 marks a free slot
+	struct Triangle
+	{
+		std::array<int, 3> v;
+		std::array<int, 3> n;
+	};
+
+	double orient(const Point& a, const Point& b, const Point& c)
+	{
+		return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	}
+
+	bool inCircle(const Point& a, const Point& b, const Point& c, const Point& p)
+	{
+		const double adx{ a.x - p.x }, ady{ a.y - p.y };
+		const double bdx{ b.x - p.x }, bdy{ b.y - p.y };
+		const double cdx{ c.x - p.x }, cdy{ c.y - p.y };
+
+		return (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy)
+			- (bdx * bdx + bdy * bdy) * (adx * cdy - cdx * ady)
+			+ (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady) > 0.;
+	}
+
+	std::vector<std::pair<int, int>> sortedUnique(std::vector<std::pair<int, int>> edges)
+	{
+		std::ranges::sort(edges);
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+		return edges;
+	}
+
+	float cellSizeFor(const std::vector<sf::Vector2f>& points, const float pointsPerCell)
+	{
+		float minX{ points.front().x }, maxX{ minX }, minY{ points.front().y }, maxY{ minY };
+		for (const sf::Vector2f point : points)
+		{
+			minX = std::min(minX, point.x);
+			maxX = std::max(maxX, point.x);
+			minY = std::min(minY, point.y);
+			maxY = std::max(maxY, point.y);
+		}
+
+		return std::max(maxX - minX, maxY - minY) * std::sqrt(pointsPerCell / points.size());
+	}
+}
+
+namespace astar::geometry
+{
+	std::vector<std::pair<int, int>> kNearestEdges(const std::vector<sf::Vector2f>& points, const int k)
+	{
+		if (points.size() < 2 || k <= 0) return {};
+
+		SpatialGrid grid;
+		grid.build(points, cellSizeFor(points, 2.f));
+
+		std::vector<std::pair<int, int>> edges;
+		edges.reserve(points.size() * k);
+		for (int i = 0; i < std::ssize(points); i++)
+		{
+			for (const int j : grid.nearest(points[i], k, i))
+			{
+				edges.emplace_back(std::min(i, j), std::max(i, j));
+			}
+		}
+
+		return sortedUnique(std::move(edges));
+	}
+
+	std::vector<std::pair<int, int>> radiusEdges(const std::vector<sf::Vector2f>& points, const float radius)
+	{
+		if (points.size() < 2 || radius <= 0.f) return {};
+
+		SpatialGrid grid;
+		grid.build(points, radius);
+
+		std::vector<std::pair<int, int>> edges;
+		for (int i = 0; i < std::ssize(points); i++)
+		{
+			grid.queryRadius(points[i], radius, [&](const int j)
+				{
+					if (j > i)
+					{
+						edges.emplace_back(i, j);
+					}
+				});
+		}
+
+		return edges;
+	}
+
+	//Bowyer-Watson, points are inserted in grid order and located by walking from the last new triangle
+	std::vector<std::pair<int, int>> delaunayEdges(const std::vector<sf::Vector2f>& points)
+	{
+		const int count{ static_cast<int>(points.size()) };
+		if (count < 2) return {};
+		if (count == 2) return { { 0, 1 } };
+
+		std::vector<Point> p;
+		p.reserve(count + 3);
+		double minX{ points.front().x }, maxX{ minX }, minY{ points.front().y }, maxY{ minY };
+		for (const sf::Vector2f point : points)
+		{
+			p.push_back({ point.x, point.y });
+			minX = std::min<double>(minX, point.x);
+			maxX = std::max<double>(maxX, point.x);
+			minY = std::min<double>(minY, point.y);
+			maxY = std::max<double>(maxY, point.y);
+		}
+
+		//a super triangle far enough out to contain every circumcircle that matters
+		const double extent{ std::max({ maxX - minX, maxY - minY, 1. }) };
+		const double centerX{ (minX + maxX) / 2. };
+		const double centerY{ (minY + maxY) / 2. };
+		p.push_back({ centerX - 40. * extent, centerY - 20. * extent });
+		p.push_back({ centerX + 40. * extent, centerY - 20. * extent });
+		p.push_back({ centerX, centerY + 40. * extent });
+
+		std::vector<Triangle> triangles{ { { count, count + 1, count + 2 }, { -1, -1, -1 } } };
+		std::vector<int> freeSlots;
+		std::vector<int> marks(1, 0);
+
+		//serpentine rows of cells keep consecutive points next to each other so the walks stay short
+		const double cell{ extent / std::sqrt(static_cast<double>(count)) };
+		std::vector<int> order(count);
+		for (int i = 0; i < count; i++)
+		{
+			order[i] = i;
+		}
+		const auto cellKey = [&](const int i)
+			{
+				const long long row{ static_cast<long long>((p[i].y - minY) / cell) };
+				const long long column{ static_cast<long long>((p[i].x - minX) / cell) };
+				return std::pair{ row, row % 2 ? -column : column };
+			};
+		std::ranges::sort(order, [&](const int left, const int right) { return cellKey(left) < cellKey(right); });
+
+		std::vector<int> cavity;
+		std::vector<std::array<int, 3>> boundary; //edge start, edge end, triangle on the other side
+		std::vector<int> created;
+		int last{ 0 };
+		int stamp{ 0 };
+
+		for (const int index : order)
+		{
+			const Point& q = p[index];
+
+			int current{ last };
+			for (size_t steps = 0;; steps++)
+			{
+				const Triangle& triangle = triangles[current];
+				int next{ -1 };
+				for (int e = 0; e < 3; e++)
+				{
+					const int i{ static_cast<int>((e + steps) % 3) };
+					if (triangle.n[i] != -1 && orient(p[triangle.v[(i + 1) % 3]], p[triangle.v[(i + 2) % 3]], q) < 0.)
+					{
+						next = triangle.n[i];
+						break;
+					}
+				}
+
+				if (next == -1) break;
+				current = next;
+
+				//walks only loop on degenerate input, fall back to a scan
+				if (steps > triangles.size())
+				{
+					for (int t = 0; t < std::ssize(triangles); t++)
+					{
+						const Triangle& candidate = triangles[t];
+						if (candidate.v[0] != -1 &&
+							orient(p[candidate.v[0]], p[candidate.v[1]], q) >= 0. &&
+							orient(p[candidate.v[1]], p[candidate.v[2]], q) >= 0. &&
+							orient(p[candidate.v[2]], p[candidate.v[0]], q) >= 0.)
+						{
+							current = t;
+							break;
+						}
+					}
+					break;
+				}
+			}
+
+			++stamp;
+			cavity.assign(1, current);
+			marks[current] = stamp;
+			for (size_t i = 0; i < cavity.size(); i++)
+			{
+				for (const int neighbour : triangles[cavity[i]].n)
+				{
+					if (neighbour == -1 || marks[neighbour] == stamp) continue;
+
+					const Triangle& triangle = triangles[neighbour];
+					if (inCircle(p[triangle.v[0]], p[triangle.v[1]], p[triangle.v[2]], q))
+					{
+						marks[neighbour] = stamp;
+						cavity.push_back(neighbour);
+					}
+				}
+			}
+
+			boundary.clear();
+			for (const int t : cavity)
+			{
+				const Triangle& triangle = triangles[t];
+				for (int i = 0; i < 3; i++)
+				{
+					if (triangle.n[i] == -1 || marks[triangle.n[i]] != stamp)
+					{
+						boundary.push_back({ triangle.v[(i + 1) % 3], triangle.v[(i + 2) % 3], triangle.n[i] });
+					}
+				}
+			}
+
+			for (const int t : cavity)
+			{
+				triangles[t].v[0] = -1;
+				freeSlots.push_back(t);
+			}
+
+			created.clear();
+			for (const auto& [a, b, outer] : boundary)
+			{
+				int slot;
+				if (!freeSlots.empty())
+				{
+					slot = freeSlots.back();
+					freeSlots.pop_back();
+				}
+				else
+				{
+					slot = static_cast<int>(triangles.size());
+					triangles.emplace_back();
+					marks.push_back(0);
+				}
+
+				triangles[slot] = { { a, b, index }, { -1, -1, outer } };
+				created.push_back(slot);
+
+				if (outer != -1)
+				{
+					Triangle& other = triangles[outer];
+					for (int j = 0; j < 3; j++)
+					{
+						if (other.v[(j + 1) % 3] == b && other.v[(j + 2) % 3] == a)
+						{
+							other.n[j] = slot;
+						}
+					}
+				}
+			}
+
+			//the new fan around q: the edge (b, q) of one triangle is the edge (q, b) of the one starting at b
+			for (const int t : created)
+			{
+				Triangle& triangle = triangles[t];
+				for (const int other : created)
+				{
+					if (triangles[other].v[0] == triangle.v[1]) triangle.n[0] = other;
+					if (triangles[other].v[1] == triangle.v[0]) triangle.n[1] = other;
+				}
+			}
+
+			last = created.front();
+		}
+
+		std::vector<std::pair<int, int>> edges;
+		edges.reserve(count * 3);
+		for (const Triangle& triangle : triangles)
+		{
+			if (triangle.v[0] == -1) continue;
+
+			for (int i = 0; i < 3; i++)
+			{
+				const int a{ triangle.v[(i + 1) % 3] };
+				const int b{ triangle.v[(i + 2) % 3] };
+				if (a < b && b < count)
+				{
+					edges.emplace_back(a, b);
+				}
+			}
+		}
+
+		return edges;
+	}
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <utility>
+
+
+//Edge sets of geometric graphs over a point set, edges are index pairs into points with first < second
+namespace astar::geometry
+{
+	std::vector<std::pair<int, int>> kNearestEdges(const std::vector<sf::Vector2f>& points, const int k);
+	std::vector<std::pair<int, int>> radiusEdges(const std::vector<sf::Vector2f>& points, const float radius);
+	std::vector<std::pair<int, int>> delaunayEdges(const std::vector<sf::Vector2f>& points);
+}
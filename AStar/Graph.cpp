@@ -4,7 +4,16 @@
 #include "Timer.hpp"
 #include "Utils.hpp"
 #include <random>
-#include "Console.hpp"
+#include "Journal.hpp"
+#include "Sampling.hpp"
+#include "Geometry.hpp"
+#include <SFML/System/Clock.hpp>
+#include <unordered_map>
+#include <ostream>
+#include <sstream>
+#include <cstdint>
+#include <array>
+#include <numbers>
 
 
 namespace
@@ -13,13 +22,49 @@ namespace
 	{
 		return (conn1.first == conn2.first && conn1.second == conn2.second) || (conn1.first == conn2.second && conn1.second == conn2.first);
 	}
+
+	template<typename Type>
+	void splitString(std::vector<Type>& vec, std::string str, const char delim)
+	{
+		if constexpr (std::is_same<Type, std::string>::value)
+		{
+			size_t pos;
+			while ((pos = str.find(delim)) != std::string::npos)
+			{
+				vec.emplace_back(str.substr(0, pos));
+				str.erase(0, pos + 1);
+			}
+			vec.emplace_back(str);
+		}
+		else if constexpr (std::is_same<Type, float>::value)
+		{
+			std::vector<Type> temp;
+
+			try
+			{
+				size_t pos;
+				while ((pos = str.find(delim)) != std::string::npos)
+				{
+					temp.emplace_back(std::stof(str.substr(0, pos)));
+					str.erase(0, pos + 1);
+				}
+				temp.emplace_back(std::stof(str));
+			}
+			catch (...)
+			{
+				return;
+			}
+
+			vec = std::move(temp);
+		}
+	}
 }
 
 namespace astar
 {
 	Graph& Graph::get()
 	{
-		static Graph graph;
+		static Graph graph(&Journal::get());
 		return graph;
 	}
 
@@ -39,18 +84,19 @@ namespace astar
 	bool Graph::addNode(const sf::Vector2f& pos, const int id, const bool collision)
 	{
 		if (nodeWithIdExists(id)) return false;
+		reserveNodes(nodesCached_.size() + 1);
 		nodesCached_.emplace_back(pos.x, pos.y, id < 0 ? ++freeInd_ : id, collision);
+		++version_;
+		if (journal_) journal_->recordAddNode(nodesCached_.back().id(), pos, collision);
 		return true;
 	}
 
 	void Graph::addNodeForce(const sf::Vector2f pos, const int id)
 	{
+		reserveNodes(nodesCached_.size() + 1);
 		nodesCached_.emplace_back(pos.x, pos.y, id < 0 ? ++freeInd_ : id, false);
-	}
-
-	void Graph::increaseOffset(const float offset)
-	{
-		offset_ += offset;
+		++version_;
+		if (journal_) journal_->recordAddNode(nodesCached_.back().id(), pos, false);
 	}
 
 	void Graph::selectNodes(const sf::Vector2f& mousePos)
@@ -77,12 +123,7 @@ namespace astar
 
 	void Graph::toggleConnectionMode()
 	{
-		connectionText_.setString((buildConnectionMode_ = !buildConnectionMode_) ? "Connection Mode: True\n" : "Connection Mode: False\n");
-	}
-
-	void Graph::toggleDrawScore()
-	{
-		drawScore_ = !drawScore_;
+		buildConnectionMode_ = !buildConnectionMode_;
 	}
 
 	bool Graph::setStart(const int id)
@@ -137,6 +178,13 @@ namespace astar
 		return false;
 	}
 
+	std::optional<std::pair<int, int>> Graph::targetIds() const
+	{
+		if (!startTarget_ || !endTarget_) return std::nullopt;
+
+		return std::pair{ startTarget_->id(), endTarget_->id() };
+	}
+
 	const std::vector<std::pair<int, int>>& Graph::connectionsCRef() const
 	{
 		return connections_;
@@ -154,90 +202,215 @@ namespace astar
 
 	std::optional<std::string> Graph::executeAStar()
 	{
-		Graph::get().setAStarResult(false, 0.f);
+		return executeSearch(SearchEngine::AStar);
+	}
+
+	std::optional<std::string> Graph::executeSearch(const SearchEngine engine)
+	{
+		setAStarResult(false, 0.f);
 		sf::Clock clk;
 		if (!startTarget_ || !endTarget_)
 		{
 			return std::nullopt;
 		}
 
-		for (auto& node : nodesCached_)
+		const auto result = findPath(startTarget_->id(), endTarget_->id(), engine);
+		showSearchResult(startTarget_->id(), endTarget_->id(), engine, result);
+
+		if (!result || !result->found)
 		{
-			node.fScore_ = std::numeric_limits<float>::max();
-			node.gScore_ = std::numeric_limits<float>::max();
-			node.parent_ = nullptr;
+			return std::nullopt;
 		}
 
-		for (auto& connection : connectionsCached_)
+		return std::to_string(clk.restart().asSeconds());
+	}
+
+	//colours a result that may have been computed on a copy of this graph, it must belong to the current version
+	void Graph::showSearchResult(const int startId, const int endId, const SearchEngine engine, const std::shared_ptr<const PathResult>& result)
+	{
+		if (result)
 		{
-			connection.line_.setFillColor(sf::Color(200, 200, 200));
+			pathCache_.insert(startId, endId, engine, version_, result);
+		}
 
-			if (!connection.end_->isCollision())
-			{
-				connection.end_->circle_.setOutlineColor(sf::Color::White);
-			}
+		resetPathColors();
+		expandedNodes_ = result ? result->expanded : 0;
+		searchStats_ = result ? result->stats : SearchStats{};
+		setAStarResult(result && result->found, result && result->found ? result->length : 0.f);
 
-			if (!connection.start_->isCollision())
+		if (result && result->found)
+		{
+			highlightPath(result->path);
+		}
+	}
+
+	std::shared_ptr<const PathResult> Graph::findPath(const int startId, const int endId, const SearchEngine engine)
+	{
+		const Timer timer("Graph::findPath");
+
+		if (auto cached = pathCache_.find(startId, endId, engine, version_))
+		{
+			return cached;
+		}
+
+		const auto start = std::ranges::find_if(nodesCached_, [startId](const Node& node) { return node.id() == startId; });
+		const auto end = std::ranges::find_if(nodesCached_, [endId](const Node& node) { return node.id() == endId; });
+		if (start == nodesCached_.end() || end == nodesCached_.end() || (engine != SearchEngine::AStar && !isGridGraph()))
+		{
+			return nullptr;
+		}
+
+		auto result = std::make_shared<PathResult>(false, 0.f, 0);
+
+		if (engine == SearchEngine::AStar)
+		{
+			runAStar(static_cast<uint32_t>(start - nodesCached_.begin()), static_cast<uint32_t>(end - nodesCached_.begin()), *result);
+		}
+		else if (const auto jpsResult = jps_.search(start - nodesCached_.begin(), end - nodesCached_.begin(), engine == SearchEngine::JpsPlus))
+		{
+			result->found = true;
+			result->length = jpsResult->length;
+			result->expanded = jpsResult->expanded;
+			result->stats = jpsResult->stats;
+			result->path.reserve(jpsResult->path.size());
+			for (const size_t index : jpsResult->path)
 			{
-				connection.start_->circle_.setOutlineColor(sf::Color::White);
+				result->path.push_back(nodesCached_[index].id());
 			}
 		}
 
-		std::vector<Node*> openSet{ startTarget_ };
-		startTarget_->gScore_ = 0;
-		startTarget_->fScore_ = utils::euclidDistance(startTarget_->pos(), endTarget_->pos());
+		pathCache_.insert(startId, endId, engine, version_, result);
+		return result;
+	}
+
+	bool Graph::runAStar(const uint32_t start, const uint32_t end, PathResult& result)
+	{
+		++marksVersion_; //the scores change
+		liveSearch_.reset(); //both keep their scores in searchScratch_
+
+		AStarSearch search(searchGraph(), searchScratch_, start, end);
+		result.found = search.step(std::numeric_limits<size_t>::max()) == AStarSearch::State::Found;
+		result.length = search.length();
+		result.expanded = search.expanded();
+		result.path = search.path();
+		result.stats = search.stats();
+		return result.found;
+	}
+
+	bool Graph::startLiveSearch(const size_t expansionsPerFrame)
+	{
+		if (!startTarget_ || !endTarget_) return false;
+
+		resetPathColors();
+		setAStarResult(false, 0.f);
+		liveSearch_.reset();
+		liveSearch_ = std::make_unique<AStarSearch>(searchGraph(), searchScratch_, static_cast<uint32_t>(startTarget_ - nodesCached_.data()), static_cast<uint32_t>(endTarget_ - nodesCached_.data()), true);
+		liveSearchVersion_ = version_;
+		liveSearchTargets_ = { startTarget_->id(), endTarget_->id() };
+		liveExpansionsPerFrame_ = expansionsPerFrame;
+		++marksVersion_;
+		return true;
+	}
+
+	bool Graph::isSearching() const
+	{
+		return liveSearch_ != nullptr;
+	}
+
+	//runs at most liveExpansionsPerFrame_ expansions and never longer than liveFrameBudget_, returns a message once the search is over
+	std::optional<std::string> Graph::advanceLiveSearch()
+	{
+		if (!liveSearch_) return std::nullopt;
+
+		if (version_ != liveSearchVersion_)
+		{
+			liveSearch_.reset();
+			return "&&Rgraph changed, animated search stopped";
+		}
 
-		while (!openSet.empty())
+		//picking other targets doesn't change the version, but the result would be cached under the new pair
+		if (targetIds() != liveSearchTargets_)
 		{
-			Node* current{ openSet.back() };
+			liveSearch_.reset();
+			return "&&Rtargets changed, animated search stopped";
+		}
 
-			if (current == endTarget_)
-			{
-				Graph::get().setAStarResult(true, current->fScore_);
+		const auto state = liveSearch_->step(liveExpansionsPerFrame_, AStarSearch::Clock::now() + liveFrameBudget_);
 
-				while (current->parent_)
-				{
-					for (auto& connection : connectionsCached_)
-					{
-						if ((connection.end_ == current || connection.end_ == current->parent_) && (connection.start_ == current || connection.start_ == current->parent_))
-						{
-							connection.line_.setFillColor(sf::Color::Blue);
-							connection.end_->circle_.setOutlineColor(sf::Color::Blue);
-							connection.start_->circle_.setOutlineColor(sf::Color::Blue);
-						}
-					}
+		for (const uint32_t node : liveSearch_->takeOpened())
+		{
+			nodesCached_[node].mark_ = Mark::Opened;
+		}
 
-					current = current->parent_;
-				}
+		for (const uint32_t node : liveSearch_->takeClosed())
+		{
+			nodesCached_[node].mark_ = Mark::Closed;
+		}
 
-				return std::to_string(clk.restart().asSeconds());
-			}
+		++marksVersion_;
 
-			openSet.pop_back();
+		if (state == AStarSearch::State::Running) return std::nullopt;
 
-			for (Node* neighbor : current->connections_)
-			{
-				if (neighbor->isCollision()) continue;
+		auto result = std::make_shared<PathResult>(state == AStarSearch::State::Found, liveSearch_->length(), liveSearch_->expanded(), liveSearch_->path(), liveSearch_->stats());
+		liveSearch_.reset();
+		showSearchResult(liveSearchTargets_.first, liveSearchTargets_.second, SearchEngine::AStar, result);
 
-				const float tScore = current->gScore_ + utils::euclidDistance(current->pos(), neighbor->pos());
+		if (!result->found) return "&&Gno path found";
 
-				if (tScore < neighbor->gScore_)
-				{
-					neighbor->parent_ = current;
-					neighbor->gScore_ = tScore;
-					neighbor->fScore_ = tScore + utils::euclidDistance(neighbor->pos(), endTarget_->pos());
+		return std::format("&&Gpath found, length: {}, nodes expanded: {}", result->length, result->expanded);
+	}
 
-					if (std::ranges::find(openSet, neighbor) == openSet.end())
-					{
-						openSet.push_back(neighbor);
-					}
-				}
-			}
+	//the index copy A* walks, rebuilt when the graph changed since the last search
+	const SearchGraph& Graph::searchGraph()
+	{
+		if (searchGraphVersion_ != version_)
+		{
+			searchGraph_.build(nodesCached_);
+			searchGraphVersion_ = version_;
+		}
+
+		return searchGraph_;
+	}
+
+	//g and f score the last A* over the graph gave the node at index, max for nodes it didn't reach
+	std::pair<float, float> Graph::scores(const size_t index) const
+	{
+		constexpr float unreached{ std::numeric_limits<float>::max() };
+		if (searchGraphVersion_ != version_ || !searchScratch_.reached(static_cast<uint32_t>(index))) return { unreached, unreached };
 
-			std::ranges::sort(openSet, [](const Node* left, const Node* right) { return left->fScore_ > right->fScore_; });
+		const float gScore{ searchScratch_.gScore[index] };
+		return { gScore, gScore + utils::euclidDistance(nodesCached_[index].pos(), nodesCached_[searchScratch_.goal].pos()) };
+	}
+
+	bool Graph::isGridGraph()
+	{
+		if (jpsVersion_ != version_)
+		{
+			jps_.build(nodesCached_, connections_);
+			jpsVersion_ = version_;
 		}
 
-		return std::nullopt;
+		return jps_.isGrid();
+	}
+
+	size_t Graph::expandedNodes() const
+	{
+		return expandedNodes_;
+	}
+
+	const SearchStats& Graph::searchStats() const
+	{
+		return searchStats_;
+	}
+
+	uint64_t Graph::version() const
+	{
+		return version_;
+	}
+
+	PathCache& Graph::pathCache()
+	{
+		return pathCache_;
 	}
 
 	void Graph::toggleRapidConnect()
@@ -250,180 +423,269 @@ namespace astar
 		return rapidConnect_;
 	}
 
-	void Graph::generateRandomGraph(const int nodesCount, const float chance, const float radius)
+	int Graph::generateRandomGraph(const int nodesCount, const float chance, const float radius)
 	{
-		const float originalChance{ chance };
-		constexpr int maxTries{ 10000 };
-		resetNodes();
-		std::uniform_real_distribution<float> dist(-radius, radius);
-		std::uniform_real_distribution<float> p(0.f, 1.f);
-		std::uniform_int_distribution<int> pathLength(2, nodesCount - 1);
-		static std::mt19937_64 mt(std::random_device{}());
+		const Timer timer("Graph::generateRandomGraph");
 
-		sf::Vector2f pos{ dist(mt), dist(mt) };
+		placeRandomNodes(nodesCount, radius, mt_);
 
-		int tries{ 0 };
-		for (int i = 0; i < nodesCount; ++i)
+		//Batagelj-Brandes: jump straight to the next accepted pair (v, w), w < v, with geometrically distributed gaps
+		const long long placed{ static_cast<long long>(nodesCached_.size()) };
+		std::vector<std::pair<int, int>> edges;
+		if (chance >= 1.f)
 		{
-			bool valid = true;
-			while (!isValidPosition(pos, radius) && ++tries < maxTries)
+			edges.reserve(placed * (placed - 1) / 2);
+			for (int v = 1; v < placed; v++)
 			{
-				valid = false;
-				pos = { dist(mt), dist(mt) };
-				valid = true;
+				for (int w = 0; w < v; w++)
+				{
+					edges.emplace_back(w, v);
+				}
 			}
-
-			if (valid && tries != maxTries)
+		}
+		else if (chance > 0.f)
+		{
+			edges.reserve(static_cast<size_t>(chance * placed * (placed - 1) / 2 * 1.1) + 16);
+			const double logSkip{ std::log1p(-static_cast<double>(chance)) };
+			std::uniform_real_distribution<double> r(0., 1.);
+			long long v{ 1 };
+			long long w{ -1 };
+			while (v < placed)
 			{
-				addNodeForce(pos);
-			}
+				w += 1 + static_cast<long long>(std::floor(std::log1p(-r(mt_)) / logSkip));
+				while (w >= v && v < placed)
+				{
+					w -= v;
+					++v;
+				}
 
-			tries = 0;
+				if (v < placed)
+				{
+					edges.emplace_back(static_cast<int>(w), static_cast<int>(v));
+				}
+			}
 		}
 
-		std::vector<int> pathIds;
-		//pathIds.resize(pathLength(mt));
-		//
-		//std::string command{ "path 1" };
-		//
-		//for (int& id : pathIds)
-		//{
-		//	id = pathLength(mt);
-		//}
+		connectIndices(edges);
+		selectGeneratedTargets();
 
-		pathIds.resize(nodesCount);
+		return static_cast<int>(placed);
+	}
 
-		for (int i = 0; i < pathIds.size(); i++)
+	int Graph::generateGeometricGraph(const GeometricGraph kind, const int nodesCount, const float parameter, const float radius)
+	{
+		const Timer timer("Graph::generateGeometricGraph");
+
+		const std::vector<sf::Vector2f> positions{ placeRandomNodes(nodesCount, radius, mt_) };
+
+		std::vector<std::pair<int, int>> edges;
+		switch (kind)
 		{
-			pathIds[i] = i + 1;
+		case GeometricGraph::KNearest:
+			edges = geometry::kNearestEdges(positions, static_cast<int>(parameter));
+			break;
+		case GeometricGraph::Radius:
+			edges = geometry::radiusEdges(positions, parameter);
+			break;
+		case GeometricGraph::Delaunay:
+			edges = geometry::delaunayEdges(positions);
+			break;
 		}
 
-		//std::ranges::sort(pathIds);
+		connectIndices(edges);
+		selectGeneratedTargets();
+
+		return static_cast<int>(positions.size());
+	}
 
-		//pathIds.erase(std::unique(pathIds.begin(), pathIds.end()), pathIds.end());
+	int Graph::generateGrid(const int width, const int height, const float obstacleChance)
+	{
+		const Timer timer("Graph::generateGrid");
 
-		//for (const int id : pathIds)
-		//{
-		//	command += " " + std::to_string(id);
-		//}
+		placeLattice(width, height);
 
-		//long iter = 0;
-		for (int i = 1; i <= nodesCount; i++)
+		//8-connected lattice, every cell links to its right, lower and both lower diagonal neighbours
+		std::vector<std::pair<int, int>> edges;
+		edges.reserve(static_cast<size_t>(width) * height * 4);
+		for (int y = 0; y < height; y++)
 		{
-			for (int j = i+1; j <= nodesCount; j++)
+			for (int x = 0; x < width; x++)
 			{
-				//iter++;
-				if (p(mt) < chance)
+				const int index{ y * width + x };
+				if (x + 1 < width) edges.emplace_back(index, index + 1);
+				if (y + 1 < height)
 				{
-					addIdConnectionForce(i, j);
-					//chance = originalChance;
+					edges.emplace_back(index, index + width);
+					if (x + 1 < width) edges.emplace_back(index, index + width + 1);
+					if (x > 0) edges.emplace_back(index, index + width - 1);
 				}
 			}
 		}
+		connectIndices(edges);
 
-		//std::cout << chance << '\n';
-		//std::cout << "ITERATIONS: " << iter << '\n';
+		//obstacles are collision nodes so the lattice stays intact for jump point search, the corners stay walkable
+		if (obstacleChance > 0.f)
+		{
+			std::bernoulli_distribution obstacle(std::min(obstacleChance, 1.f));
+			for (size_t i = 1; i + 1 < nodesCached_.size(); i++)
+			{
+				if (obstacle(mt_))
+				{
+					nodesCached_[i].toggleCollision();
+					if (journal_) journal_->recordCollision(nodesCached_[i].id(), true);
+				}
+			}
+			++version_;
+		}
 
-		//command += " " + std::to_string(nodesCount);
+		selectGeneratedTargets();
 
-		//std::string linkCommand{ "link" };
-		std::string setStart{ "set start 1" };
-		std::string setEnd{ "set end " + std::to_string(nodesCount) };
-		Console::get().executeCommand(setStart);
-		Console::get().executeCommand(setEnd);
-		//Console::get().executeCommand(command);
+		return static_cast<int>(nodesCached_.size());
 	}
 
-	bool Graph::isValidPosition(const sf::Vector2f pos, const float radius)
+	int Graph::generateMaze(const int width, const int height)
 	{
-		if (utils::euclidDistance({ 0,0 }, pos) > radius)
-		{
-			return false;
-		}
+		const Timer timer("Graph::generateMaze");
 
-		constexpr float distSquared{ 68.f * 68.f };
-		for (const Node& node : nodesCached_)
+		placeLattice(width, height);
+		if (nodesCached_.empty()) return 0;
+
+		//iterative recursive backtracker, carves a uniform-ish spanning tree of the 4-connected lattice
+		std::vector<std::pair<int, int>> edges;
+		edges.reserve(nodesCached_.size() - 1);
+		std::vector<bool> visited(nodesCached_.size());
+		std::vector<int> stack{ 0 };
+		visited[0] = true;
+		std::array<int, 4> candidates;
+
+		while (!stack.empty())
 		{
-			if (utils::euclidDistanceSquared(node.pos(), pos) <= distSquared)
+			const int index{ stack.back() };
+			const int x{ index % width };
+			const int y{ index / width };
+
+			size_t count{ 0 };
+			if (x > 0 && !visited[index - 1]) candidates[count++] = index - 1;
+			if (x + 1 < width && !visited[index + 1]) candidates[count++] = index + 1;
+			if (y > 0 && !visited[index - width]) candidates[count++] = index - width;
+			if (y + 1 < height && !visited[index + width]) candidates[count++] = index + width;
+
+			if (count == 0)
 			{
-				return false;
+				stack.pop_back();
+				continue;
 			}
+
+			const int next{ candidates[std::uniform_int_distribution<size_t>(0, count - 1)(mt_)] };
+			visited[next] = true;
+			edges.emplace_back(index, next);
+			stack.push_back(next);
 		}
 
-		return true;
+		connectIndices(edges);
+		selectGeneratedTargets();
+
+		return static_cast<int>(nodesCached_.size());
 	}
 
-	void Graph::draw(const sf::Vector2f& mousePos)
+	std::vector<sf::Vector2f> Graph::placeRandomNodes(const int nodesCount, const float radius, std::mt19937_64& mt)
 	{
-		if (savedNode_)
-		{
-			sf::RectangleShape rect({ savedNode_->distanceFromMouse(mousePos), 5 });
-			rect.setOrigin(0, 2.5);
-			rect.setRotation(utils::getAngleDeg(mousePos, savedNode_->pos()));
-			rect.setPosition(savedNode_->pos());
-			rt_->draw(rect);
-		}
+		resetNodes();
 
-		for (const auto& connection : connectionsCached_)
+		std::vector<sf::Vector2f> positions{ sampling::poissonDisk(nodesCount, radius, minNodeDistance_, mt) };
+		reserveNodes(positions.size());
+		for (const sf::Vector2f pos : positions)
 		{
-			rt_->draw(connection.line_);
+			addNodeForce(pos);
 		}
 
-		for (const auto& node : nodesCached_)
-		{
-			rt_->draw(node.circle_);
+		return positions;
+	}
 
-			if (drawDistance_)
-			{
-				text_.setPosition(node.pos().x - 35.f, node.pos().y + 32.f);
-				text_.setString(std::to_string(node.distanceFromMouse(mousePos)));
-				text_.setFillColor(sf::Color::White);
-				rt_->draw(text_);
-			}
+	//growing the node buffer moves every Node, so all pointers into it are rebased
+	void Graph::reserveNodes(const size_t capacity)
+	{
+		if (capacity <= nodesCached_.capacity()) return;
+
+		const Node* oldBase{ nodesCached_.data() };
+		nodesCached_.reserve(std::max(capacity, nodesCached_.capacity() * 2));
+		rebaseNodePointers(oldBase);
+	}
 
-			if (drawIds_)
+	void Graph::rebaseNodePointers(const Node* oldBase)
+	{
+		Node* base{ nodesCached_.data() };
+		if (base == oldBase) return;
+
+		//the old buffer may already be freed, so only its address is used
+		const auto rebase = [base, old = reinterpret_cast<std::uintptr_t>(oldBase)](Node*& node)
 			{
-				const std::string nodeId = std::to_string(node.id());
-				const float width = nodeId.size() * offset_ / 2.f;
-				text_.setPosition(node.pos().x - width, node.pos().y - 14.f);
-				text_.setString(nodeId);
-				text_.setFillColor(sf::Color::Black);
-				text_.setCharacterSize(24);
-				rt_->draw(text_);
-				text_.setCharacterSize(16);
-			}
+				if (node)
+				{
+					node = base + (reinterpret_cast<std::uintptr_t>(node) - old) / sizeof(Node);
+				}
+			};
 
-			if (drawScore_)
+		for (Node& node : nodesCached_)
+		{
+			for (Node*& conn : node.connections_)
 			{
-				text_.setPosition(node.pos().x - 100.f, node.pos().y + 30.f);
-				text_.setString(std::format("fScore: {}\ngScore: {}", node.fScore_, node.gScore_));
-				text_.setFillColor(sf::Color::White);
-				rt_->draw(text_);
+				rebase(conn);
 			}
 		}
+
+		for (Connection& connection : connectionsCached_)
+		{
+			rebase(connection.start_);
+			rebase(connection.end_);
+		}
+
+		rebase(startTarget_);
+		rebase(endTarget_);
+		rebase(savedNode_);
 	}
 
-	void Graph::drawStats()
+	void Graph::placeLattice(const int width, const int height)
 	{
-		connectionText_.setString(buildConnectionMode_ ? "Connection Mode: True\n" : "Connection Mode: False\n");
+		resetNodes();
+		if (width <= 0 || height <= 0) return;
 
-		if (buildConnectionMode_)
+		const sf::Vector2f origin{ -(width - 1) * latticeSpacing_ / 2.f, -(height - 1) * latticeSpacing_ / 2.f };
+		reserveNodes(static_cast<size_t>(width) * height);
+		for (int y = 0; y < height; y++)
 		{
-			connectionText_.setString(connectionText_.getString() + (rapidConnect_ ? "Rapid Connect: True\n" : "Rapid Connect: False\n"));
+			for (int x = 0; x < width; x++)
+			{
+				addNodeForce({ origin.x + x * latticeSpacing_, origin.y + y * latticeSpacing_ });
+			}
 		}
+	}
 
-		if (startTarget_)
+	void Graph::selectGeneratedTargets()
+	{
+		if (nodesCached_.empty()) return;
+
+		setStart(nodesCached_.front().id());
+		setEnd(nodesCached_.back().id());
+	}
+
+	bool Graph::isValidPosition(const sf::Vector2f pos, const float radius)
+	{
+		if (utils::euclidDistance({ 0,0 }, pos) > radius)
 		{
-			connectionText_.setString(connectionText_.getString() + "Start Target: " + std::to_string(startTarget_->id()) + '\n');
+			return false;
 		}
 
-		if (endTarget_)
+		constexpr float distSquared{ minNodeDistance_ * minNodeDistance_ };
+		for (const Node& node : nodesCached_)
 		{
-			connectionText_.setString(connectionText_.getString() + "End Target: " + std::to_string(endTarget_->id()));
+			if (utils::euclidDistanceSquared(node.pos(), pos) <= distSquared)
+			{
+				return false;
+			}
 		}
 
-		rt_->draw(connectionText_);
-		connectionText_.setString("");
+		return true;
 	}
 
 	void Graph::setCollision(const sf::Vector2f& mousePos)
@@ -433,6 +695,8 @@ namespace astar
 			if (node.isMouseOver(mousePos))
 			{
 				node.toggleCollision();
+				++version_;
+				if (journal_) journal_->recordCollision(node.id(), node.isCollision());
 				break;
 			}
 		}
@@ -448,12 +712,15 @@ namespace astar
 		Node* checkMouseUp = checkMouseOnSomething(mousePos);
 		if (checkMouseUp && !savedNode_)
 		{
-			checkMouseUp->changePos(mousePos);
 			savedNode_ = checkMouseUp;
 		}
-		else if (savedNode_)
+
+		//dragging sends an event per mouse move, only an actual move invalidates the caches
+		if (savedNode_ && savedNode_->pos() != mousePos)
 		{
 			savedNode_->changePos(mousePos);
+			++version_;
+			if (journal_) journal_->recordMoveNode(savedNode_->id(), mousePos);
 		}
 	}
 
@@ -481,16 +748,6 @@ namespace astar
 
 	}
 
-	void Graph::toggleDrawDistance()
-	{
-		drawDistance_ = !drawDistance_;
-	}
-
-	void Graph::setDrawIds(const bool drawIds)
-	{
-		drawIds_ = drawIds;
-	}
-
 	Node* Graph::checkMouseOnSomething(const sf::Vector2f& mousePos)
 	{
 		for (auto& node : nodesCached_)
@@ -519,12 +776,10 @@ namespace astar
 					savedNode_->connections_.emplace_back(&node);
 					node.connections_.emplace_back(savedNode_);
 					connections_.emplace_back(savedNode_->id(), node.id());
+					++version_;
+					if (journal_) journal_->recordAddConnection(savedNode_->id(), node.id());
 
-					connectionsCached_.emplace_back(savedNode_,
-						&node,
-						1,
-						utils::euclidDistance(savedNode_->pos(), node.pos()),
-						utils::getAngleDeg(node.pos(), savedNode_->pos()));
+					connectionsCached_.emplace_back(savedNode_, &node, 1);
 
 #ifdef _DEBUG
 					for (const auto& [left, right] : connections_)
@@ -549,6 +804,8 @@ namespace astar
 	void Graph::addIdConnectionForce(const int id1, const int id2)
 	{
 		connections_.push_back({ id1,id2 });
+		++version_;
+		if (journal_) journal_->recordAddConnection(id1, id2);
 
 		for (Node& nodeL : nodesCached_)
 		{
@@ -561,12 +818,7 @@ namespace astar
 						nodeL.connections_.emplace_back(&nodeR);
 						nodeR.connections_.emplace_back(&nodeL);
 
-						connectionsCached_.emplace_back(
-							&nodeR,
-							&nodeL,
-							1,
-							utils::euclidDistance(nodeL.pos(), nodeR.pos()),
-							utils::getAngleDeg(nodeL.pos(), nodeR.pos()));
+						connectionsCached_.emplace_back(&nodeR, &nodeL, 1);
 
 						return;
 					}
@@ -582,6 +834,8 @@ namespace astar
 		if (!connectionExists(connection))
 		{
 			connections_.push_back(connection);
+			++version_;
+			if (journal_) journal_->recordAddConnection(connection.first, connection.second);
 
 			for (Node& nodeL : nodesCached_)
 			{
@@ -594,12 +848,7 @@ namespace astar
 							nodeL.connections_.emplace_back(&nodeR);
 							nodeR.connections_.emplace_back(&nodeL);
 
-							connectionsCached_.emplace_back(
-								&nodeR,
-								&nodeL,
-								1,
-								utils::euclidDistance(nodeL.pos(), nodeR.pos()),
-								utils::getAngleDeg(nodeL.pos(), nodeR.pos()));
+							connectionsCached_.emplace_back(&nodeR, &nodeL, 1);
 
 							return true;
 						}
@@ -611,6 +860,90 @@ namespace astar
 		return false;
 	}
 
+	//edges are pairs of indices into nodesCached_, adjacency is reserved up front so the whole batch is one pass
+	void Graph::connectIndices(const std::vector<std::pair<int, int>>& edges)
+	{
+		std::vector<size_t> degrees(nodesCached_.size());
+		for (const auto& [left, right] : edges)
+		{
+			++degrees[left];
+			++degrees[right];
+		}
+
+		for (size_t i = 0; i < nodesCached_.size(); i++)
+		{
+			nodesCached_[i].connections_.reserve(nodesCached_[i].connections_.size() + degrees[i]);
+		}
+
+		connections_.reserve(connections_.size() + edges.size());
+		connectionsCached_.reserve(connectionsCached_.size() + edges.size());
+		for (const auto& [left, right] : edges)
+		{
+			Node& nodeL = nodesCached_[left];
+			Node& nodeR = nodesCached_[right];
+			connections_.emplace_back(nodeL.id(), nodeR.id());
+			nodeL.connections_.emplace_back(&nodeR);
+			nodeR.connections_.emplace_back(&nodeL);
+
+			connectionsCached_.emplace_back(&nodeR, &nodeL, 1);
+
+			if (journal_) journal_->recordAddConnection(nodeL.id(), nodeR.id());
+		}
+
+		++version_;
+	}
+
+	bool Graph::removeIdConnection(const std::pair<int, int>& connection)
+	{
+		if (std::erase_if(connections_, [&connection](const std::pair<int, int>& conn) { return conn == connection; }) == 0)
+		{
+			return false;
+		}
+
+		std::erase_if(connectionsCached_, [&connection](const Connection& conn)
+			{
+				return std::pair<int, int>{ conn.start_->id(), conn.end_->id() } == connection;
+			});
+
+		for (Node& node : nodesCached_)
+		{
+			if (node.id() == connection.first || node.id() == connection.second)
+			{
+				std::erase_if(node.connections_, [&connection](const Node* conn) { return conn->id() == connection.first || conn->id() == connection.second; });
+			}
+		}
+
+		++version_;
+		if (journal_) journal_->recordDeleteConnection(connection.first, connection.second);
+		return true;
+	}
+
+	bool Graph::setNodePosition(const int id, const sf::Vector2f& pos)
+	{
+		const auto node = std::ranges::find_if(nodesCached_, [id](const Node& node) { return node.id() == id; });
+		if (node == nodesCached_.end()) return false;
+
+		node->changePos(pos);
+		++version_;
+		if (journal_) journal_->recordMoveNode(id, pos);
+		return true;
+	}
+
+	bool Graph::setNodeCollision(const int id, const bool collision)
+	{
+		const auto node = std::ranges::find_if(nodesCached_, [id](const Node& node) { return node.id() == id; });
+		if (node == nodesCached_.end()) return false;
+
+		if (node->isCollision() != collision)
+		{
+			node->toggleCollision();
+			++version_;
+		}
+
+		if (journal_) journal_->recordCollision(id, collision);
+		return true;
+	}
+
 	void Graph::resetNodes()
 	{
 		startTarget_ = nullptr;
@@ -620,10 +953,14 @@ namespace astar
 		connectionsCached_.clear();
 		connections_.clear();
 		freeInd_ = 0;
+		++version_;
+		if (journal_) journal_->recordReset();
 	}
 
 	void Graph::deleteNode(const int id)
 	{
+		if (journal_) journal_->recordDeleteNode(id);
+
 		std::erase_if(connections_, [id](const std::pair<int, int>& con) { return con.first == id || con.second == id; });
 
 		std::erase_if(nodesCached_, [id](const Node& node)
@@ -652,6 +989,10 @@ namespace astar
 
 	void Graph::handleRecalculate()
 	{
+		const Timer timer("Graph::handleRecalculate");
+
+		++version_;
+
 		for (auto& nd : nodesCached_)
 		{
 			nd.connections_.clear();
@@ -672,12 +1013,7 @@ namespace astar
 							nodeL.connections_.emplace_back(&nodeR);
 							nodeR.connections_.emplace_back(&nodeL);
 
-							connectionsCached_.emplace_back(
-								&nodeR,
-								&nodeL,
-								1,
-								utils::euclidDistance(nodeL.pos(), nodeR.pos()),
-								utils::getAngleDeg(nodeL.pos(), nodeR.pos()));
+							connectionsCached_.emplace_back(&nodeR, &nodeL, 1);
 						}
 					}
 				}
@@ -685,9 +1021,41 @@ namespace astar
 		}
 	}
 
-	void Graph::setRenderTarget(sf::RenderTarget* rt)
+	void Graph::resetPathColors()
 	{
-		rt_ = rt;
+		for (auto& connection : connectionsCached_)
+		{
+			connection.mark_ = Mark::None;
+			connection.end_->mark_ = Mark::None;
+			connection.start_->mark_ = Mark::None;
+		}
+
+		++marksVersion_;
+	}
+
+	void Graph::highlightPath(const std::vector<int>& path)
+	{
+		std::unordered_map<int, size_t> order;
+		order.reserve(path.size());
+		for (size_t i = 0; i < path.size(); i++)
+		{
+			order.emplace(path[i], i);
+		}
+
+		for (auto& connection : connectionsCached_)
+		{
+			const auto start = order.find(connection.start_->id());
+			const auto end = order.find(connection.end_->id());
+
+			if (start != order.end() && end != order.end() && (start->second + 1 == end->second || end->second + 1 == start->second))
+			{
+				connection.mark_ = Mark::Path;
+				connection.end_->mark_ = Mark::Path;
+				connection.start_->mark_ = Mark::Path;
+			}
+		}
+
+		++marksVersion_;
 	}
 
 	void Graph::setAStarResult(const bool result, const float pathLength)
@@ -701,17 +1069,227 @@ namespace astar
 		return pathLength_;
 	}
 
-	Graph::Graph() : drawDistance_{ false }, savedNode_{}, freeInd_{}, shouldRecalculate_{}, offset_{ 15.f },
-					 drawIds_{}, startTarget_{}, endTarget_{}, buildConnectionMode_{}, rapidConnect_{}, drawScore_{}, rt_{}, pathLength_{}, pathFound_{}
+	void Graph::writeSnapshot(std::ostream& os) const
+	{
+		const Timer timer("Graph::writeSnapshot");
+
+		for (const Node& node : nodesCached_)
+		{
+			std::string connections;
+
+			connections += (std::to_string(node.id()) + ':');
+
+			for (const Node* conn : node.connections_)
+			{
+				connections += (std::to_string(conn->id()) + ':');
+			}
+			connections.erase(connections.end() - 1);
+
+			os << std::format("{},{},{},{},{}\n", node.pos().x, node.pos().y, node.id(), static_cast<int>(node.isCollision()), connections);
+		}
+	}
+
+	bool Graph::readSnapshot(std::istream& is, const std::function<void(const std::string&)>& print)
+	{
+		const Timer timer("Graph::readSnapshot");
+
+		std::string line;
+		std::vector<std::tuple<float, float, int, bool>> splitNodes;
+		std::vector<std::string> stringsToSplit;
+
+		while (std::getline(is, line) && line != "\n")
+		{
+			stringsToSplit.push_back(line);
+#ifdef _DEBUG
+			std::cout << line << '\n';
+#endif
+		}
+
+		std::stringstream ss;
+		ss << "&&G";
+
+		resetNodes();
+		std::vector<std::vector<float>> connectionsVec;
+
+		int count{};
+		for (auto& str : stringsToSplit)
+		{
+			++count;
+			if (std::ranges::count(str, ',') != 4)
+			{
+				print("&&Rill formed data '" + str + "' - skipping\n");
+				continue;
+			}
+
+			std::vector<std::string> split;
+			splitString(split, str, ',');
+
+			if (split.size() != 5)
+			{
+				print(std::format("&&Rnumber of fields in '{}' at line number {} is wrong, expected 5 but got {} - skipping\n", str, count, split.size()));
+				continue;
+			}
+
+			std::vector<float> connections;
+			splitString(connections, split.back(), ':');
+
+			if (connections.empty())
+			{
+				print(std::format("&&Rbad argument in '{}' at line number {}  - skipping\n", str, count));
+				continue;
+			}
+
+			split.pop_back();
+			connectionsVec.push_back(std::move(connections));
+
+			try
+			{
+				splitNodes.push_back({ std::stof(split[0]), std::stof(split[1]), std::stof(split[2]), std::stoi(split[3]) });
+			}
+			catch (const std::exception& e)
+			{
+				print("&&Rbad data - " + std::string(e.what()) + '\n');
+				return false;
+			}
+		}
+
+		reserveNodes(splitNodes.size());
+		for (const auto& [x, y, id, isCollision] : splitNodes)
+		{
+			if (addNode({ x,y }, id, isCollision))
+			{
+				ss << std::format("adding node at ({},{}) with id {} and collision {}\n", x, y, id, isCollision ? "on" : "off");
+			}
+			else
+			{
+				ss << std::format("node with id {} already exists - skipping\n", id);
+			}
+		}
+
+		for (const auto& connection : connectionsVec)
+		{
+			for (int i = 1; i < std::ssize(connection); i++)
+			{
+				if (addIdConnection({ connection[0], connection[i] }))
+				{
+					ss << "adding connection " << connection[0] << "<->" << connection[i] << '\n';
+				}
+				else
+				{
+					ss << std::format("connection {}<->{} already exists - skipping\n", connection[0], connection[i]);
+				}
+			}
+		}
+
+		resetIndex();
+
+		print(ss.str());
+		return true;
+	}
+
+	//a detached copy for background work, Node pointers are moved over to the new buffers
+	void Graph::copyFrom(const Graph& other)
+	{
+		nodesCached_ = other.nodesCached_;
+		connectionsCached_ = other.connectionsCached_;
+		connections_ = other.connections_;
+		startTarget_ = other.startTarget_;
+		endTarget_ = other.endTarget_;
+		savedNode_ = nullptr;
+		rebaseNodePointers(other.nodesCached_.data());
+		freeInd_ = other.freeInd_;
+		version_ = other.version_;
+	}
+
+	//copy for background jobs, made once per version so the jump point grid, the JPS+ table and the path cache
+	//built on it are reused by every later job until the graph changes
+	std::shared_ptr<Graph> Graph::searchSnapshot()
+	{
+		if (!searchSnapshot_ || searchSnapshot_->version_ != version_)
+		{
+			searchSnapshot_ = std::make_shared<Graph>();
+			searchSnapshot_->copyFrom(*this);
+		}
+
+		return searchSnapshot_;
+	}
+
+	//takes over a graph built in the background, moving the buffers keeps every Node pointer valid
+	void Graph::adopt(Graph& other)
+	{
+		nodesCached_ = std::move(other.nodesCached_);
+		connectionsCached_ = std::move(other.connectionsCached_);
+		connections_ = std::move(other.connections_);
+		startTarget_ = other.startTarget_;
+		endTarget_ = other.endTarget_;
+		savedNode_ = nullptr;
+		freeInd_ = other.freeInd_;
+		version_ = std::max(version_, other.version_) + 1;
+		other.resetNodes();
+
+		//a whole new graph goes to a fresh snapshot in the background, one record per node and edge is only the fallback
+		//for when an unfinished compaction left its rotated journal behind
+		if (journal_ && !journal_->compact(true))
+		{
+			journal_->recordReset();
+			for (const Node& node : nodesCached_)
+			{
+				journal_->recordAddNode(node.id(), node.pos(), node.isCollision());
+			}
+			for (const auto& [left, right] : connections_)
+			{
+				journal_->recordAddConnection(left, right);
+			}
+		}
+	}
+
+	void Graph::seed(const uint64_t seed)
+	{
+		mt_.seed(seed);
+	}
+
+	std::vector<std::pair<int, int>> Graph::randomQueries(const size_t count, const uint64_t seed) const
+	{
+		std::vector<int> candidates;
+		for (const Node& node : nodesCached_)
+		{
+			if (!node.isCollision())
+			{
+				candidates.push_back(node.id());
+			}
+		}
+
+		std::vector<std::pair<int, int>> queries;
+		if (candidates.size() < 2) return queries;
+
+		std::mt19937_64 mt(seed);
+		std::uniform_int_distribution<size_t> pick(0, candidates.size() - 1);
+		queries.reserve(count);
+		while (queries.size() < count)
+		{
+			const int start{ candidates[pick(mt)] };
+			const int end{ candidates[pick(mt)] };
+			if (start != end)
+			{
+				queries.emplace_back(start, end);
+			}
+		}
+
+		return queries;
+	}
+
+	Graph::Graph() : savedNode_{}, freeInd_{}, shouldRecalculate_{}, buildConnectionMode_{}, rapidConnect_{}, pathFound_{}, pathLength_{}, startTarget_{}, endTarget_{},
+					 version_{}, marksVersion_{}, jpsVersion_{ std::numeric_limits<uint64_t>::max() }, expandedNodes_{}, searchGraphVersion_{ std::numeric_limits<uint64_t>::max() }, liveSearchVersion_{}, liveExpansionsPerFrame_{},
+					 journal_{}, mt_{ std::random_device{}() }
+	{
+	}
+
+	//the interactive graph keeps Node pointers stable through typical editing sessions
+	Graph::Graph(Journal* journal) : Graph()
 	{
+		journal_ = journal;
 		nodesCached_.reserve(10000);
 		connectionsCached_.reserve(20000);
 		connections_.reserve(20000);
-		font_.loadFromFile("mono.ttf");
-		connectionText_.setFont(font_);
-		connectionText_.setString("Connection Mode: False");
-		connectionText_.setPosition(5, 15);
-		text_.setCharacterSize(16);
-		text_.setFont(font_);
 	}
 }
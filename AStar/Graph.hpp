@@ -2,77 +2,139 @@
 
 #include <vector>
 #include "Node.hpp"
+#include "JumpPointSearch.hpp"
+#include "AStarSearch.hpp"
+#include "PathCache.hpp"
 #include <ranges>
 #include <optional>
+#include <random>
+#include <iosfwd>
+#include <functional>
+#include <memory>
+#include <chrono>
+#include <string>
 
 
 namespace astar
 {
+	class Journal;
+	class GraphRenderer;
+
+	enum class GeometricGraph
+	{
+		KNearest,
+		Radius,
+		Delaunay
+	};
+
 	class Graph
 	{
 	public:
+		Graph(); //a detached instance, edits are not journaled
 		void operator=(const Graph&) = delete;
 		Graph(const Graph&) = delete;
 		static Graph& get();
 		void resetIndex();
 		bool addNode(const sf::Vector2f& pos, const int id = -1, const bool collision = false);
 		void addNodeForce(const sf::Vector2f pos, const int id = -1);
-		void draw(const sf::Vector2f& mousePos);
-		void drawStats();
 		void checkAndDelete(const sf::Vector2f& mousePos);
-		void toggleDrawDistance();
 		void setCollision(const sf::Vector2f& mousePos);
 		void makeConnection(const sf::Vector2f& mousePos);
 		bool addIdConnection(const std::pair<int, int>& connection);
 		void addIdConnectionForce(const int id1, const int id2);
+		bool removeIdConnection(const std::pair<int, int>& connection);
+		bool setNodePosition(const int id, const sf::Vector2f& pos);
+		bool setNodeCollision(const int id, const bool collision);
 		void resetNodes();
 		void deleteNode(const int id);
-		void increaseOffset(const float offset);
 		Node* checkMouseOnSomething(const sf::Vector2f& mousePos);
 		void moveNode(sf::Vector2f mousePos);
 		void clearSavedNode();
-		void setDrawIds(const bool drawIds);
 		void selectNodes(const sf::Vector2f& mousePos);
 		bool isBuildConnectionMode() const;
 		void toggleConnectionMode();
-		void toggleDrawScore();
 		bool setStart(const int id);
 		bool setEnd(const int id);
+		std::optional<std::pair<int, int>> targetIds() const;
 		const std::vector<std::pair<int, int>>& connectionsCRef() const;
 		const std::vector<Connection>& connectionsCachedCRef() const;
 		const std::vector<Node>& nodesCRef() const;
 		std::optional<std::string> executeAStar();
+		std::optional<std::string> executeSearch(const SearchEngine engine);
+		std::shared_ptr<const PathResult> findPath(const int startId, const int endId, const SearchEngine engine);
+		bool startLiveSearch(const size_t expansionsPerFrame);
+		bool isSearching() const;
+		std::optional<std::string> advanceLiveSearch();
+		bool isGridGraph();
+		size_t expandedNodes() const;
+		const SearchStats& searchStats() const;
+		uint64_t version() const;
+		PathCache& pathCache();
 		void toggleRapidConnect();
 		bool isRapidConnect() const;
-		void generateRandomGraph(const int nodesCount, const float chance, const float radius);
+		int generateRandomGraph(const int nodesCount, const float chance, const float radius);
+		int generateGeometricGraph(const GeometricGraph kind, const int nodesCount, const float parameter, const float radius);
+		int generateGrid(const int width, const int height, const float obstacleChance);
+		int generateMaze(const int width, const int height);
 		bool isValidPosition(const sf::Vector2f pos, const float radius);
-		void setRenderTarget(sf::RenderTarget* rt);
 		void setAStarResult(const bool result, const float pathLength);
 		float pathLength() const;
+		void writeSnapshot(std::ostream& os) const;
+		bool readSnapshot(std::istream& is, const std::function<void(const std::string&)>& print);
+		void copyFrom(const Graph& other);
+		std::shared_ptr<Graph> searchSnapshot();
+		void adopt(Graph& other);
+		void showSearchResult(const int startId, const int endId, const SearchEngine engine, const std::shared_ptr<const PathResult>& result);
+		void seed(const uint64_t seed);
+		std::vector<std::pair<int, int>> randomQueries(const size_t count, const uint64_t seed) const;
 	private:
+		friend class GraphRenderer; //draws the nodes, targets and search state without copying them
+		explicit Graph(Journal* journal);
 		bool nodeWithIdExists(const int id) const;
 		bool connectionExists(const std::pair<int, int>& connection) const;
 		void handleRecalculate();
-		float offset_;
-		bool drawIds_;
-		Graph();
+		void reserveNodes(const size_t capacity);
+		void rebaseNodePointers(const Node* oldBase);
+		std::vector<sf::Vector2f> placeRandomNodes(const int nodesCount, const float radius, std::mt19937_64& mt);
+		void placeLattice(const int width, const int height);
+		void connectIndices(const std::vector<std::pair<int, int>>& edges);
+		void selectGeneratedTargets();
+		static constexpr float minNodeDistance_{ 68.f };
+		static constexpr float latticeSpacing_{ 80.f };
+		bool runAStar(const uint32_t start, const uint32_t end, PathResult& result);
+		const SearchGraph& searchGraph();
+		std::pair<float, float> scores(const size_t index) const;
+		void resetPathColors();
+		void highlightPath(const std::vector<int>& path);
 		Node* savedNode_; //Saved Node to make Connections between
 		std::vector<Node> nodesCached_;
 		std::vector<Connection> connectionsCached_;
-		sf::Font font_;
-		sf::Text connectionText_;
-		sf::Text text_;
-		bool drawDistance_;
 		int freeInd_;
 		bool shouldRecalculate_;
 		bool buildConnectionMode_;
 		bool rapidConnect_;
-		bool drawScore_;
 		bool pathFound_;
 		float pathLength_;
 		Node* startTarget_;
 		Node* endTarget_;
-		sf::RenderTarget* rt_;
 		std::vector<std::pair<int, int>> connections_;
+		uint64_t version_; //bumped by every mutation, keys the path cache and the jump point grid
+		uint64_t marksVersion_; //bumped when search marks or scores change, the positions stay
+		JumpPointSearch jps_;
+		uint64_t jpsVersion_;
+		PathCache pathCache_;
+		size_t expandedNodes_;
+		SearchStats searchStats_; //of the result shown last
+		std::shared_ptr<Graph> searchSnapshot_; //only the job thread searches it, jobs run one at a time
+		SearchGraph searchGraph_;
+		uint64_t searchGraphVersion_;
+		SearchScratch searchScratch_; //of the last A*, the renderer shows its scores
+		std::unique_ptr<AStarSearch> liveSearch_; //animated search between the targets, advanced once per frame
+		uint64_t liveSearchVersion_;
+		std::pair<int, int> liveSearchTargets_; //start and end ids the animated search was started with
+		size_t liveExpansionsPerFrame_;
+		static constexpr std::chrono::milliseconds liveFrameBudget_{ 8 };
+		Journal* journal_; //only the singleton records its edits
+		std::mt19937_64 mt_;
 	};
 }
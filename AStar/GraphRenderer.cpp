@@ -0,0 +1,595 @@
+#include "GraphRenderer.hpp"
+#include "Console.hpp"
+#include "Timer.hpp"
+#include "Utils.hpp"
+#include <array>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <numbers>
+
+
+namespace
+{
+	sf::Color outlineColor(const astar::Node& node)
+	{
+		if (node.isCollision()) return sf::Color::Red;
+
+		switch (node.mark_)
+		{
+		case astar::Mark::Opened:
+			return sf::Color::Green;
+		case astar::Mark::Closed:
+			return sf::Color(255, 140, 0);
+		case astar::Mark::Path:
+			return sf::Color::Blue;
+		default:
+			return sf::Color::White;
+		}
+	}
+
+	sf::Color connectionColor(const astar::Connection& connection)
+	{
+		return connection.mark_ == astar::Mark::Path ? sf::Color::Blue : sf::Color(200, 200, 200);
+	}
+}
+
+namespace astar
+{
+	GraphRenderer& GraphRenderer::get()
+	{
+		static GraphRenderer renderer(Graph::get());
+		return renderer;
+	}
+
+	//the commands work without a window, the command line front end adds them too when it's built with graphics
+	void GraphRenderer::registerCommands()
+	{
+		Console::get().addCommand("render", [](const std::vector<std::string>& args)
+			{
+				if (args.size() != 3)
+				{
+					Console::get().print("&&Rneed 'render <file> <width> <height>'!");
+					return;
+				}
+
+				const auto width = utils::parseUnsigned(args[1]);
+				const auto height = utils::parseUnsigned(args[2]);
+				if (!width || !height || *width == 0 || *height == 0)
+				{
+					Console::get().print("&&Rwidth and height need to be positive numbers!");
+					return;
+				}
+
+				sf::Clock clock;
+				if (!GraphRenderer::get().renderToFile(args[0], static_cast<unsigned int>(*width), static_cast<unsigned int>(*height)))
+				{
+					Console::get().print("&&Rcan't render to file '" + args[0] + "'!");
+					return;
+				}
+
+				Console::get().print(std::format("&&Grendered {}x{} to file '{}' in {}s", *width, *height, args[0], clock.getElapsedTime().asSeconds()));
+			}, true);
+	}
+
+	GraphRenderer::GraphRenderer(const Graph& graph) : graph_{ graph }, offset_{ 15.f }, drawIds_{}, drawScore_{}, drawDistance_{ false }, rt_{}, shortEdgeLength_{},
+		indexVersion_{ std::numeric_limits<uint64_t>::max() }, geometryVersion_{ std::numeric_limits<uint64_t>::max() }, marksVersion_{}, labelsVisible_{}, labelsDirty_{}, labelStyle_{ 1 }
+	{
+		font_.loadFromFile("mono.ttf");
+		connectionText_.setFont(font_);
+		connectionText_.setString("Connection Mode: False");
+		connectionText_.setPosition(5, 15);
+		text_.setCharacterSize(16);
+		text_.setFont(font_);
+	}
+
+	void GraphRenderer::draw(const sf::Vector2f& mousePos)
+	{
+		const Timer timer("GraphRenderer::draw");
+
+		if (graph_.savedNode_)
+		{
+			sf::RectangleShape rect({ graph_.savedNode_->distanceFromMouse(mousePos), 5 });
+			rect.setOrigin(0, 2.5);
+			rect.setRotation(utils::getAngleDeg(mousePos, graph_.savedNode_->pos()));
+			rect.setPosition(graph_.savedNode_->pos());
+			rt_->draw(rect);
+		}
+
+		drawBatched(*rt_);
+
+		if (drawDistance_ && labelsVisible_)
+		{
+			text_.setFillColor(sf::Color::White);
+			nodeIndex_.queryRadius(mousePos, distanceOverlayRadius_, [&](const int index)
+				{
+					const Node& node = graph_.nodesCached_[index];
+					text_.setPosition(node.pos().x - 35.f, node.pos().y + 32.f);
+					text_.setString(std::to_string(node.distanceFromMouse(mousePos)));
+					rt_->draw(text_);
+				});
+		}
+	}
+
+	void GraphRenderer::drawBatched(sf::RenderTarget& target)
+	{
+		const sf::View& view = target.getView();
+		const sf::FloatRect visible{ view.getCenter() - view.getSize() / 2.f, view.getSize() };
+		if (geometryVersion_ != graph_.version_ || marksVersion_ != graph_.marksVersion_ || geometryView_ != visible)
+		{
+			rebuildGeometry(visible, visible.width > 0.f ? target.getSize().x * view.getViewport().width / visible.width : 1.f);
+		}
+
+		target.draw(edgeVertices_);
+		target.draw(nodeVertices_);
+
+		if (labelsDirty_)
+		{
+			rebuildLabels();
+		}
+
+		target.draw(idLabels_, &font_.getTexture(idLabelSize_));
+		target.draw(scoreLabels_, &font_.getTexture(scoreLabelSize_));
+	}
+
+	//fits the whole graph into an image of the given size, images larger than one texture are drawn tile by tile
+	bool GraphRenderer::renderToFile(const std::string& path, const unsigned int width, const unsigned int height)
+	{
+		if (graph_.nodesCached_.empty() || width == 0 || height == 0) return false;
+
+		sf::Vector2f min{ graph_.nodesCached_.front().pos() };
+		sf::Vector2f max{ min };
+		for (const Node& node : graph_.nodesCached_)
+		{
+			min.x = std::min(min.x, node.pos().x);
+			min.y = std::min(min.y, node.pos().y);
+			max.x = std::max(max.x, node.pos().x);
+			max.y = std::max(max.y, node.pos().y);
+		}
+
+		const float margin{ (Node::radius_ + Node::border_) * 2.f };
+		const sf::Vector2f extent{ max - min + sf::Vector2f(margin, margin) * 2.f };
+		const float unitsPerPixel{ std::max(extent.x / width, extent.y / height) };
+		const sf::Vector2f origin{ (min + max) / 2.f - sf::Vector2f(static_cast<float>(width), static_cast<float>(height)) * unitsPerPixel / 2.f };
+
+		//the tile is only as large as the image, tiling only starts above the maximum texture size. It outlives the call,
+		//so batches of same-sized renders don't recreate the context every time
+		const unsigned int maxTileSize{ std::min(sf::Texture::getMaximumSize(), maxRenderTileSize_) };
+		const sf::Vector2u tileSize{ std::min(maxTileSize, width), std::min(maxTileSize, height) };
+		if (!renderTile_)
+		{
+			renderTile_ = std::make_unique<sf::RenderTexture>();
+		}
+
+		if (renderTile_->getSize() != tileSize && !renderTile_->create(tileSize.x, tileSize.y))
+		{
+			return false;
+		}
+
+		geometryVersion_ = std::numeric_limits<uint64_t>::max(); //the window rebuilds its own view next frame
+
+		const auto renderTile = [&](const unsigned int left, const unsigned int top, const unsigned int tileWidth, const unsigned int tileHeight)
+			{
+				sf::View view(sf::FloatRect(origin.x + left * unitsPerPixel, origin.y + top * unitsPerPixel, tileWidth * unitsPerPixel, tileHeight * unitsPerPixel));
+				view.setViewport(sf::FloatRect(0.f, 0.f, static_cast<float>(tileWidth) / tileSize.x, static_cast<float>(tileHeight) / tileSize.y));
+				renderTile_->setView(view);
+				renderTile_->clear();
+				drawBatched(*renderTile_);
+				renderTile_->display();
+			};
+
+		if (tileSize == sf::Vector2u(width, height))
+		{
+			renderTile(0, 0, width, height);
+			return renderTile_->getTexture().copyToImage().saveToFile(path);
+		}
+
+		sf::Image image;
+		image.create(width, height);
+
+		for (unsigned int top = 0; top < height; top += tileSize.y)
+		{
+			for (unsigned int left = 0; left < width; left += tileSize.x)
+			{
+				const unsigned int tileWidth{ std::min(tileSize.x, width - left) };
+				const unsigned int tileHeight{ std::min(tileSize.y, height - top) };
+
+				renderTile(left, top, tileWidth, tileHeight);
+				image.copy(renderTile_->getTexture().copyToImage(), left, top, sf::IntRect(0, 0, tileWidth, tileHeight));
+			}
+		}
+
+		return image.saveToFile(path);
+	}
+
+	void GraphRenderer::drawStats()
+	{
+		connectionText_.setString(graph_.isBuildConnectionMode() ? "Connection Mode: True\n" : "Connection Mode: False\n");
+
+		if (graph_.isBuildConnectionMode())
+		{
+			connectionText_.setString(connectionText_.getString() + (graph_.isRapidConnect() ? "Rapid Connect: True\n" : "Rapid Connect: False\n"));
+		}
+
+		if (graph_.startTarget_)
+		{
+			connectionText_.setString(connectionText_.getString() + "Start Target: " + std::to_string(graph_.startTarget_->id()) + '\n');
+		}
+
+		if (graph_.endTarget_)
+		{
+			connectionText_.setString(connectionText_.getString() + "End Target: " + std::to_string(graph_.endTarget_->id()) + '\n');
+		}
+
+		if (graph_.expandedNodes())
+		{
+			connectionText_.setString(connectionText_.getString() + "Expanded: " + std::to_string(graph_.expandedNodes()) + '\n');
+
+			if constexpr (SearchStats::enabled)
+			{
+				const SearchStats& stats = graph_.searchStats();
+				connectionText_.setString(connectionText_.getString() + std::format("Relaxed: {}\nPushes: {}\nDecrease Keys: {}\nPops: {}\nPeak Open: {}\nReconstruction: {:.1f}us",
+					stats.relaxed, stats.pushes, stats.decreaseKeys, stats.pops, stats.peakOpen, stats.reconstructionMicroseconds));
+			}
+		}
+
+		rt_->draw(connectionText_);
+		connectionText_.setString("");
+	}
+
+	void GraphRenderer::toggleDrawDistance()
+	{
+		drawDistance_ = !drawDistance_;
+	}
+
+	//the distance overlay and the pending connection line follow the cursor
+	bool GraphRenderer::tracksMouse() const
+	{
+		return drawDistance_ || graph_.savedNode_;
+	}
+
+	void GraphRenderer::setDrawIds(const bool drawIds)
+	{
+		drawIds_ = drawIds;
+		labelsDirty_ = true;
+	}
+
+	void GraphRenderer::increaseOffset(const float offset)
+	{
+		offset_ += offset;
+		++labelStyle_; //the ids are centred with it
+		labelsDirty_ = true;
+	}
+
+	void GraphRenderer::toggleDrawScore()
+	{
+		drawScore_ = !drawScore_;
+		labelsDirty_ = true;
+	}
+
+	void GraphRenderer::rebuildSpatialIndex()
+	{
+		const Timer timer("GraphRenderer::rebuildSpatialIndex");
+
+		std::vector<sf::Vector2f> points;
+		points.reserve(graph_.nodesCached_.size());
+		for (const Node& node : graph_.nodesCached_)
+		{
+			points.push_back(node.pos());
+		}
+		nodeIndex_.build(points, 4.f * (Node::radius_ + Node::border_));
+
+		//edges are bucketed by midpoint, so a query only needs widening by half the longest indexed edge;
+		//the few edges far above the mean length would widen it for everyone and are kept apart instead
+		float totalLength{};
+		for (const Connection& connection : graph_.connectionsCached_)
+		{
+			totalLength += utils::euclidDistance(connection.start_->pos(), connection.end_->pos());
+		}
+		shortEdgeLength_ = graph_.connectionsCached_.empty() ? 0.f : 2.f * totalLength / graph_.connectionsCached_.size();
+
+		points.clear();
+		indexedEdges_.clear();
+		longEdges_.clear();
+		for (size_t i = 0; i < graph_.connectionsCached_.size(); i++)
+		{
+			const sf::Vector2f start{ graph_.connectionsCached_[i].start_->pos() };
+			const sf::Vector2f end{ graph_.connectionsCached_[i].end_->pos() };
+			if (utils::euclidDistance(start, end) <= shortEdgeLength_)
+			{
+				points.push_back((start + end) / 2.f);
+				indexedEdges_.push_back(i);
+			}
+			else
+			{
+				longEdges_.push_back(i);
+			}
+		}
+		edgeIndex_.build(points, std::max(shortEdgeLength_, 1.f));
+
+		indexVersion_ = graph_.version_;
+	}
+
+	void GraphRenderer::rebuildGeometry(const sf::FloatRect& visible, const float pixelsPerUnit)
+	{
+		const Timer timer("GraphRenderer::rebuildGeometry");
+
+		if (indexVersion_ != graph_.version_)
+		{
+			rebuildSpatialIndex();
+		}
+
+		edgeVertices_.clear();
+		nodeVertices_.clear();
+		visibleNodes_.clear();
+
+		//level of detail follows the on-screen node size: discs, then points, then aggregated density once the
+		//view holds more nodes than are worth drawing individually
+		size_t estimated{ 0 };
+		if ((Node::radius_ + Node::border_) * pixelsPerUnit < minDiscRadius_)
+		{
+			nodeIndex_.queryCells({ visible.left, visible.top }, { visible.left + visible.width, visible.top + visible.height }, [&estimated](const sf::Vector2f, const int count) { estimated += count; });
+		}
+
+		if (estimated > maxDetailedNodes_)
+		{
+			buildDensityTiles(visible, pixelsPerUnit);
+		}
+		else
+		{
+			buildDetailedGeometry(visible, pixelsPerUnit);
+		}
+
+		labelsVisible_ = !visibleNodes_.empty() && (Node::radius_ + Node::border_) * pixelsPerUnit >= minDiscRadius_ &&
+			scoreLabelSize_ * pixelsPerUnit >= minLabelHeight_;
+		geometryView_ = visible;
+		geometryVersion_ = graph_.version_;
+		marksVersion_ = graph_.marksVersion_;
+		labelsDirty_ = true;
+	}
+
+	void GraphRenderer::buildDetailedGeometry(const sf::FloatRect& visible, const float pixelsPerUnit)
+	{
+		constexpr size_t segments{ 24 };
+		constexpr float lineHalfWidth{ 2.5f };
+		static const std::array<sf::Vector2f, segments + 1> unitCircle = []
+			{
+				std::array<sf::Vector2f, segments + 1> points;
+				for (size_t i = 0; i <= segments; i++)
+				{
+					const float angle{ 2.f * std::numbers::pi_v<float> * i / segments };
+					points[i] = { std::cos(angle), std::sin(angle) };
+				}
+				return points;
+			}();
+
+		const float nodeRadius{ (Node::radius_ + Node::border_) * pixelsPerUnit };
+		const bool points{ nodeRadius < minDiscRadius_ };
+		const bool thinLines{ lineHalfWidth * 2.f * pixelsPerUnit < 1.f };
+		const size_t step{ nodeRadius < 10.f ? 3u : 1u }; //every third segment is plenty for small discs
+
+		//the grid takes a plain box, widened so items just outside the view that still reach into it are found
+		const auto queryWidened = [&visible](const SpatialGrid& grid, const float margin, auto&& callback)
+			{
+				grid.query({ visible.left - margin, visible.top - margin }, { visible.left + visible.width + margin, visible.top + visible.height + margin }, callback);
+			};
+
+		edgeVertices_.setPrimitiveType(thinLines ? sf::Lines : sf::Triangles);
+		const auto addEdge = [&](const size_t index)
+			{
+				const Connection& connection = graph_.connectionsCached_[index];
+				const sf::Color color{ connectionColor(connection) };
+				const sf::Vector2f start{ connection.start_->pos() };
+				const sf::Vector2f end{ connection.end_->pos() };
+				const sf::FloatRect bounds{ std::min(start.x, end.x) - lineHalfWidth, std::min(start.y, end.y) - lineHalfWidth,
+											std::abs(start.x - end.x) + 2.f * lineHalfWidth, std::abs(start.y - end.y) + 2.f * lineHalfWidth };
+				if (!bounds.intersects(visible)) return;
+
+				if (thinLines)
+				{
+					edgeVertices_.append({ start, color });
+					edgeVertices_.append({ end, color });
+					return;
+				}
+
+				const float length{ utils::euclidDistance(start, end) };
+				const sf::Vector2f normal{ length > 0.f ? sf::Vector2f(start.y - end.y, end.x - start.x) * (lineHalfWidth / length) : sf::Vector2f{} };
+
+				edgeVertices_.append({ start + normal, color });
+				edgeVertices_.append({ start - normal, color });
+				edgeVertices_.append({ end + normal, color });
+				edgeVertices_.append({ end + normal, color });
+				edgeVertices_.append({ start - normal, color });
+				edgeVertices_.append({ end - normal, color });
+			};
+
+		queryWidened(edgeIndex_, shortEdgeLength_ / 2.f + lineHalfWidth, [&](const int i) { addEdge(indexedEdges_[i]); });
+		for (const size_t index : longEdges_)
+		{
+			addEdge(index);
+		}
+
+		queryWidened(nodeIndex_, Node::radius_ + Node::border_, [this](const int i) { visibleNodes_.push_back(i); });
+		std::ranges::sort(visibleNodes_);
+
+		nodeVertices_.setPrimitiveType(sf::Triangles);
+		nodeVertices_.resize(visibleNodes_.size() * (points ? 6 : segments / step * 6));
+		sf::Vertex* vertex = visibleNodes_.empty() ? nullptr : &nodeVertices_[0];
+		for (const size_t index : visibleNodes_)
+		{
+			const Node& node = graph_.nodesCached_[index];
+			const sf::Vector2f center{ node.pos() };
+			const sf::Color outline{ outlineColor(node) };
+
+			if (points)
+			{
+				//a square of about a pixel and a half, highlighted and blocked nodes keep their outline colour
+				const float half{ 0.75f / pixelsPerUnit };
+				const sf::Color color{ outline == sf::Color::White ? sf::Color::Green : outline };
+				*vertex++ = { { center.x - half, center.y - half }, color };
+				*vertex++ = { { center.x + half, center.y - half }, color };
+				*vertex++ = { { center.x - half, center.y + half }, color };
+				*vertex++ = { { center.x - half, center.y + half }, color };
+				*vertex++ = { { center.x + half, center.y - half }, color };
+				*vertex++ = { { center.x + half, center.y + half }, color };
+				continue;
+			}
+
+			const auto disc = [&](const float radius, const sf::Color color)
+				{
+					for (size_t j = 0; j < segments; j += step)
+					{
+						*vertex++ = { center, color };
+						*vertex++ = { center + unitCircle[j] * radius, color };
+						*vertex++ = { center + unitCircle[j + step] * radius, color };
+					}
+				};
+
+			disc(Node::radius_ + Node::border_, outline);
+			disc(Node::radius_, sf::Color::Green);
+		}
+	}
+
+	void GraphRenderer::buildDensityTiles(const sf::FloatRect& visible, const float pixelsPerUnit)
+	{
+		const float tile{ densityTileSize_ / pixelsPerUnit };
+		const int columns{ std::max(static_cast<int>(std::ceil(visible.width / tile)), 1) };
+		const int rows{ std::max(static_cast<int>(std::ceil(visible.height / tile)), 1) };
+		std::vector<int> counts(static_cast<size_t>(columns) * rows);
+
+		int maxCount{ 1 };
+		nodeIndex_.queryCells({ visible.left, visible.top }, { visible.left + visible.width, visible.top + visible.height }, [&](const sf::Vector2f center, const int count)
+			{
+				const int column{ std::clamp(static_cast<int>((center.x - visible.left) / tile), 0, columns - 1) };
+				const int row{ std::clamp(static_cast<int>((center.y - visible.top) / tile), 0, rows - 1) };
+				maxCount = std::max(maxCount, counts[row * columns + column] += count);
+			});
+
+		//logarithmic shading keeps sparse regions visible next to dense ones
+		nodeVertices_.setPrimitiveType(sf::Triangles);
+		const float scale{ 1.f / std::log2(1.f + maxCount) };
+		for (int row = 0; row < rows; row++)
+		{
+			for (int column = 0; column < columns; column++)
+			{
+				const int count{ counts[row * columns + column] };
+				if (count == 0) continue;
+
+				const sf::Color color(0, 255, 0, static_cast<sf::Uint8>(64 + 191 * std::log2(1.f + count) * scale));
+				const sf::Vector2f topLeft{ visible.left + column * tile, visible.top + row * tile };
+				const sf::Vector2f bottomRight{ topLeft.x + tile, topLeft.y + tile };
+				nodeVertices_.append({ topLeft, color });
+				nodeVertices_.append({ { bottomRight.x, topLeft.y }, color });
+				nodeVertices_.append({ { topLeft.x, bottomRight.y }, color });
+				nodeVertices_.append({ { topLeft.x, bottomRight.y }, color });
+				nodeVertices_.append({ { bottomRight.x, topLeft.y }, color });
+				nodeVertices_.append({ bottomRight, color });
+			}
+		}
+	}
+
+	//copies the cached quads of the visible nodes, only nodes that changed since they were last shown are laid out again
+	void GraphRenderer::rebuildLabels()
+	{
+		const Timer timer("GraphRenderer::rebuildLabels");
+
+		idLabels_.setPrimitiveType(sf::Triangles);
+		idLabels_.clear();
+		scoreLabels_.setPrimitiveType(sf::Triangles);
+		scoreLabels_.clear();
+		labelsDirty_ = false;
+		if (!labelsVisible_ || (!drawIds_ && !drawScore_)) return;
+
+		labelCache_.resize(graph_.nodesCached_.size());
+		for (const size_t index : visibleNodes_)
+		{
+			const Node& node = graph_.nodesCached_[index];
+			NodeLabels& labels = labelCache_[index];
+
+			if (labels.id != node.id() || labels.pos != node.pos() || labels.style != labelStyle_)
+			{
+				labels.id = node.id();
+				labels.pos = node.pos();
+				labels.style = labelStyle_;
+				labels.hasId = false;
+				labels.hasScores = false;
+			}
+
+			if (drawIds_)
+			{
+				if (!labels.hasId)
+				{
+					const std::string nodeId = std::to_string(node.id());
+					const float width = nodeId.size() * offset_ / 2.f;
+					labels.idQuads.clear();
+					appendText(labels.idQuads, nodeId, { node.pos().x - width, node.pos().y - 14.f }, idLabelSize_, sf::Color::Black);
+					labels.hasId = true;
+				}
+
+				for (const sf::Vertex& vertex : labels.idQuads)
+				{
+					idLabels_.append(vertex);
+				}
+			}
+
+			if (drawScore_)
+			{
+				const auto scores = graph_.scores(index);
+				if (!labels.hasScores || labels.scores != scores)
+				{
+					labels.scores = scores;
+					labels.scoreQuads.clear();
+					appendText(labels.scoreQuads, std::format("fScore: {}\ngScore: {}", scores.second, scores.first), { node.pos().x - 100.f, node.pos().y + 30.f }, scoreLabelSize_, sf::Color::White);
+					labels.hasScores = true;
+				}
+
+				for (const sf::Vertex& vertex : labels.scoreQuads)
+				{
+					scoreLabels_.append(vertex);
+				}
+			}
+		}
+	}
+
+	//lays glyphs out the way sf::Text does, the first baseline sits one character size below pos
+	void GraphRenderer::appendText(std::vector<sf::Vertex>& vertices, const std::string& string, sf::Vector2f pos, const unsigned int size, const sf::Color color) const
+	{
+		const float left{ pos.x };
+		pos.y += size;
+		sf::Uint32 previous{ 0 };
+
+		for (const char c : string)
+		{
+			const sf::Uint32 current{ static_cast<unsigned char>(c) };
+			if (current == '\n')
+			{
+				pos = { left, pos.y + font_.getLineSpacing(size) };
+				previous = 0;
+				continue;
+			}
+
+			pos.x += font_.getKerning(previous, current, size);
+			previous = current;
+
+			const sf::Glyph& glyph = font_.getGlyph(current, size, false);
+			const sf::Vector2f topLeft{ pos.x + glyph.bounds.left, pos.y + glyph.bounds.top };
+			const sf::Vector2f bottomRight{ topLeft.x + glyph.bounds.width, topLeft.y + glyph.bounds.height };
+			const sf::Vector2f texTopLeft{ static_cast<float>(glyph.textureRect.left), static_cast<float>(glyph.textureRect.top) };
+			const sf::Vector2f texBottomRight{ texTopLeft.x + glyph.textureRect.width, texTopLeft.y + glyph.textureRect.height };
+
+			vertices.push_back({ topLeft, color, texTopLeft });
+			vertices.push_back({ { bottomRight.x, topLeft.y }, color, { texBottomRight.x, texTopLeft.y } });
+			vertices.push_back({ { topLeft.x, bottomRight.y }, color, { texTopLeft.x, texBottomRight.y } });
+			vertices.push_back({ { topLeft.x, bottomRight.y }, color, { texTopLeft.x, texBottomRight.y } });
+			vertices.push_back({ { bottomRight.x, topLeft.y }, color, { texBottomRight.x, texTopLeft.y } });
+			vertices.push_back({ bottomRight, color, texBottomRight });
+
+			pos.x += glyph.advance;
+		}
+	}
+
+	void GraphRenderer::setRenderTarget(sf::RenderTarget* rt)
+	{
+		rt_ = rt;
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Graph.hpp"
+#include "SpatialGrid.hpp"
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace astar
+{
+	//Draws Graph::get() into the window or an image, the engine itself links no graphics code
+	class GraphRenderer
+	{
+	public:
+		void operator=(const GraphRenderer&) = delete;
+		GraphRenderer(const GraphRenderer&) = delete;
+		static GraphRenderer& get();
+		static void registerCommands();
+		void draw(const sf::Vector2f& mousePos);
+		void drawStats();
+		bool renderToFile(const std::string& path, const unsigned int width, const unsigned int height);
+		void setRenderTarget(sf::RenderTarget* rt);
+		void increaseOffset(const float offset);
+		void setDrawIds(const bool drawIds);
+		void toggleDrawScore();
+		void toggleDrawDistance();
+		bool tracksMouse() const;
+	private:
+		//glyph quads of one node's labels, laid out again only when the node's id, position or scores change
+		struct NodeLabels
+		{
+			int id{};
+			sf::Vector2f pos;
+			uint64_t style{}; //labelStyle_ the quads were laid out with, 0 before the first layout
+			std::pair<float, float> scores;
+			bool hasId{};
+			bool hasScores{};
+			std::vector<sf::Vertex> idQuads;
+			std::vector<sf::Vertex> scoreQuads;
+		};
+
+		explicit GraphRenderer(const Graph& graph);
+		void rebuildSpatialIndex();
+		void drawBatched(sf::RenderTarget& target);
+		void rebuildGeometry(const sf::FloatRect& visible, const float pixelsPerUnit);
+		void buildDetailedGeometry(const sf::FloatRect& visible, const float pixelsPerUnit);
+		void buildDensityTiles(const sf::FloatRect& visible, const float pixelsPerUnit);
+		void rebuildLabels();
+		void appendText(std::vector<sf::Vertex>& vertices, const std::string& string, sf::Vector2f pos, const unsigned int size, const sf::Color color) const;
+		const Graph& graph_;
+		float offset_;
+		bool drawIds_;
+		bool drawScore_;
+		bool drawDistance_;
+		sf::Font font_;
+		sf::Text connectionText_;
+		sf::Text text_;
+		sf::RenderTarget* rt_;
+		SpatialGrid nodeIndex_;
+		SpatialGrid edgeIndex_; //midpoints of the short connections
+		std::vector<size_t> indexedEdges_; //edgeIndex_ point to connectionsCached_ index
+		std::vector<size_t> longEdges_; //connections too long for edgeIndex_, tested one by one
+		float shortEdgeLength_;
+		uint64_t indexVersion_;
+		std::vector<size_t> visibleNodes_;
+		sf::VertexArray edgeVertices_; //every visible Connection as two triangles
+		sf::VertexArray nodeVertices_; //every visible Node as an outline disc under a fill disc
+		sf::FloatRect geometryView_;
+		uint64_t geometryVersion_;
+		uint64_t marksVersion_; //of the graph when the geometry was built
+		bool labelsVisible_; //false when the current zoom makes labels unreadable
+		static constexpr float minDiscRadius_{ 3.f }; //on-screen pixels, smaller nodes become points
+		static constexpr float minLabelHeight_{ 6.f }; //on-screen pixels
+		static constexpr float densityTileSize_{ 4.f }; //on-screen pixels
+		static constexpr size_t maxDetailedNodes_{ 100000 }; //more visible nodes than this are drawn as density tiles
+		sf::VertexArray idLabels_; //glyph quads of the visible ids, textured by the idLabelSize_ font page
+		sf::VertexArray scoreLabels_; //glyph quads of the visible scores, textured by the scoreLabelSize_ font page
+		bool labelsDirty_; //the visible set changed, the cached quads are copied again
+		std::vector<NodeLabels> labelCache_; //by node index, an entry whose id doesn't match is stale
+		uint64_t labelStyle_; //bumped when every label has to be laid out again
+		static constexpr unsigned int idLabelSize_{ 24 };
+		static constexpr unsigned int scoreLabelSize_{ 16 };
+		static constexpr float distanceOverlayRadius_{ 400.f };
+		static constexpr unsigned int maxRenderTileSize_{ 4096 };
+		std::unique_ptr<sf::RenderTexture> renderTile_; //created by the first renderToFile
+	};
+}
@@ -0,0 +1,228 @@
+#include "JobSystem.hpp"
+#include "Console.hpp"
+#include "Timer.hpp"
+#include <format>
+#include <chrono>
+#include <algorithm>
+
+
+namespace astar
+{
+	JobContext::JobContext(std::stop_token stop, JobSystem& jobs) : stop_{ std::move(stop) }, jobs_{ jobs }
+	{
+	}
+
+	bool JobContext::stopRequested() const
+	{
+		return stop_.stop_requested();
+	}
+
+	void JobContext::print(std::string line)
+	{
+		jobs_.post([line = std::move(line)]
+			{
+				Console::get().print(line);
+			});
+	}
+
+	//continuations of a cancelled job are dropped, so a cancelled command never touches the graph
+	void JobContext::then(std::function<void()> continuation)
+	{
+		if (stopRequested()) return;
+
+		jobs_.post(std::move(continuation));
+	}
+
+	JobSystem& JobSystem::get()
+	{
+		static JobSystem jobs;
+		return jobs;
+	}
+
+	void JobSystem::submit(std::string name, Work work)
+	{
+		std::scoped_lock lock(mutex_);
+		queue_.push_back({ std::move(name), std::move(work) });
+		wake_.notify_one();
+	}
+
+	//a job that never returns on its own would hold up every job queued after it, it runs next to the queue instead
+	void JobSystem::spawn(std::string name, Work work)
+	{
+		const auto finished = reapServices();
+		std::scoped_lock lock(mutex_);
+		Service& service = *services_.emplace_back(std::make_unique<Service>());
+		service.name = std::move(name);
+		service.thread = std::jthread([this, &service, work = std::move(work)](std::stop_token stop)
+			{
+				JobContext context(stop, *this);
+				{
+					const Timer timer("JobSystem::service");
+					work(context);
+				}
+
+				{
+					std::scoped_lock lock(mutex_);
+					service.finished = true;
+				}
+				idle_.notify_all();
+			});
+	}
+
+	bool JobSystem::cancel()
+	{
+		std::scoped_lock lock(mutex_);
+		const bool cancelled{ !idle() || servicesRunning() };
+		queue_.clear();
+		current_.request_stop();
+		for (const auto& service : services_)
+		{
+			service->thread.request_stop();
+		}
+		idle_.notify_all();
+		return cancelled;
+	}
+
+	bool JobSystem::busy() const
+	{
+		std::scoped_lock lock(mutex_);
+		return !idle() || !uiTasks_.empty();
+	}
+
+	bool JobSystem::pump()
+	{
+		std::deque<std::function<void()>> tasks;
+		{
+			std::scoped_lock lock(mutex_);
+			tasks.swap(uiTasks_);
+		}
+
+		for (const auto& task : tasks)
+		{
+			task();
+		}
+
+		return !tasks.empty();
+	}
+
+	bool JobSystem::serving() const
+	{
+		std::scoped_lock lock(mutex_);
+		return servicesRunning();
+	}
+
+	//blocks until every queued job has run, scripts rely on commands finishing in order. Services only hold it up when
+	//asked for, results are applied while waiting so a server that runs for a long time still gets its output printed
+	void JobSystem::finish(const bool waitForServices)
+	{
+		while (true)
+		{
+			{
+				std::unique_lock lock(mutex_);
+				if (idle_.wait_for(lock, std::chrono::milliseconds(100), [&] { return idle() && !(waitForServices && servicesRunning()); })) break;
+			}
+
+			pump();
+		}
+
+		reapServices();
+		pump();
+	}
+
+	std::string JobSystem::status() const
+	{
+		std::scoped_lock lock(mutex_);
+		std::string status{ running_.empty() ? "no jobs running" : std::format("running '{}', {} queued", running_, queue_.size()) };
+		for (const auto& service : services_)
+		{
+			if (!service->finished)
+			{
+				status += std::format(", '{}' running on its own thread", service->name);
+			}
+		}
+
+		return status;
+	}
+
+	JobSystem::JobSystem() : worker_{ [this](std::stop_token stop) { run(stop); } }
+	{
+	}
+
+	JobSystem::~JobSystem()
+	{
+		cancel();
+		worker_.request_stop();
+	}
+
+	void JobSystem::post(std::function<void()> task)
+	{
+		std::scoped_lock lock(mutex_);
+		uiTasks_.push_back(std::move(task));
+	}
+
+	void JobSystem::run(std::stop_token stop)
+	{
+		//shutting down must also stop whatever job is running
+		std::stop_callback shutdown(stop, [this]
+			{
+				std::scoped_lock lock(mutex_);
+				current_.request_stop();
+			});
+
+		while (true)
+		{
+			Job job;
+			std::stop_token token;
+			{
+				std::unique_lock lock(mutex_);
+				if (!wake_.wait(lock, stop, [this] { return !queue_.empty(); })) return;
+
+				job = std::move(queue_.front());
+				queue_.pop_front();
+				running_ = job.name;
+				current_ = {};
+				token = current_.get_token();
+			}
+
+			JobContext context(token, *this);
+			{
+				const Timer timer("JobSystem::job");
+				job.work(context);
+			}
+
+			{
+				std::scoped_lock lock(mutex_);
+				running_.clear();
+			}
+			idle_.notify_all();
+		}
+	}
+
+	//finished services are handed back and joined by the caller, outside the lock their threads take on the way out
+	std::vector<std::unique_ptr<JobSystem::Service>> JobSystem::reapServices()
+	{
+		std::vector<std::unique_ptr<Service>> finished;
+		std::scoped_lock lock(mutex_);
+		for (auto& service : services_)
+		{
+			if (service->finished)
+			{
+				finished.push_back(std::move(service));
+			}
+		}
+		std::erase(services_, nullptr);
+		return finished;
+	}
+
+	//the caller holds mutex_, services don't count, they run until cancelled
+	bool JobSystem::idle() const
+	{
+		return running_.empty() && queue_.empty();
+	}
+
+	//the caller holds mutex_
+	bool JobSystem::servicesRunning() const
+	{
+		return std::ranges::any_of(services_, [](const auto& service) { return !service->finished; });
+	}
+}
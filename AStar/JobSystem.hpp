@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <functional>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <stop_token>
+#include <memory>
+#include <vector>
+
+
+namespace astar
+{
+	//Handle a running job uses to report back, everything it posts runs later on the UI thread
+	class JobContext
+	{
+	public:
+		JobContext(std::stop_token stop, class JobSystem& jobs);
+		bool stopRequested() const;
+		void print(std::string line);
+		void then(std::function<void()> continuation);
+	private:
+		std::stop_token stop_;
+		JobSystem& jobs_;
+	};
+
+	//Runs long console commands one at a time on a worker thread, the UI thread drains their results with pump().
+	//Jobs that run until cancelled (a server) get a thread of their own instead, so they don't hold up the queue
+	class JobSystem
+	{
+	public:
+		using Work = std::function<void(JobContext&)>;
+
+		void operator=(const JobSystem&) = delete;
+		JobSystem(const JobSystem&) = delete;
+		static JobSystem& get();
+		void submit(std::string name, Work work);
+		void spawn(std::string name, Work work);
+		bool cancel();
+		bool busy() const;
+		bool serving() const;
+		bool pump();
+		void finish(const bool waitForServices = false);
+		std::string status() const;
+	private:
+		struct Job
+		{
+			std::string name;
+			Work work;
+		};
+
+		struct Service
+		{
+			std::string name;
+			bool finished{};
+			std::jthread thread;
+		};
+
+		friend class JobContext;
+		JobSystem();
+		~JobSystem();
+		void post(std::function<void()> task);
+		void run(std::stop_token stop);
+		std::vector<std::unique_ptr<Service>> reapServices();
+		bool idle() const;
+		bool servicesRunning() const;
+		mutable std::mutex mutex_;
+		std::condition_variable_any wake_;
+		std::condition_variable idle_;
+		std::deque<Job> queue_;
+		std::deque<std::function<void()>> uiTasks_;
+		std::string running_;
+		std::stop_source current_; //stop source of the running job, cancel only reaches that one
+		std::jthread worker_;
+		std::vector<std::unique_ptr<Service>> services_; //declared last, joined before anything they use is destroyed
+	};
+}
@@ -0,0 +1,340 @@
+#include "Journal.hpp"
+#include "Graph.hpp"
+#include "Console.hpp"
+#include <filesystem>
+#include <format>
+#include <sstream>
+
+
+namespace astar
+{
+	Journal& Journal::get()
+	{
+		static Journal journal;
+		return journal;
+	}
+
+	Journal::Journal() : pendingCount_{}, lastMoveOffset_{}, lastMoveId_{ -1 }, replaying_{}, compacting_{}
+	{
+	}
+
+	Journal::~Journal()
+	{
+		close();
+	}
+
+	bool Journal::open(const std::string& snapshotPath)
+	{
+		close();
+
+		snapshotPath_ = snapshotPath;
+		journalPath_ = snapshotPath + ".journal";
+		file_.open(journalPath_, std::ios::out | std::ios::app);
+
+		return file_.is_open();
+	}
+
+	void Journal::close()
+	{
+		if (compactor_.joinable())
+		{
+			compactor_.join();
+		}
+
+		if (file_.is_open())
+		{
+			flush();
+			file_.close();
+		}
+	}
+
+	bool Journal::isOpen() const
+	{
+		return file_.is_open();
+	}
+
+	bool Journal::isCompacting() const
+	{
+		return compacting_;
+	}
+
+	void Journal::flush()
+	{
+		if (pending_.empty()) return;
+
+		file_ << pending_;
+		file_.flush();
+		pending_.clear();
+		pendingCount_ = 0;
+		lastMoveId_ = -1;
+	}
+
+	bool Journal::compact(const bool waitForRunning)
+	{
+		if (!isOpen() || (compacting_ && !waitForRunning)) return false;
+
+		if (compactor_.joinable())
+		{
+			compactor_.join();
+		}
+
+		//edits made while the snapshot is written go to a fresh journal, the rotated one is dropped once the snapshot is in place.
+		//A rotated journal left by an unfinished compaction is only extended when the graph already contains its edits
+		const std::string rotatedPath{ journalPath_ + ".old" };
+		std::error_code error;
+		const bool rotatedLeft{ std::filesystem::exists(rotatedPath, error) };
+		if (rotatedLeft && replayedRotated_ != rotatedPath) return false;
+
+		flush();
+		file_.close();
+		if (!rotate(rotatedLeft))
+		{
+			file_.open(journalPath_, std::ios::out | std::ios::app);
+			return false;
+		}
+		replayedRotated_ = rotatedPath;
+		file_.open(journalPath_, std::ios::out | std::ios::trunc);
+
+		std::vector<SnapshotNode> snapshot;
+		snapshot.reserve(Graph::get().nodesCRef().size());
+		for (const Node& node : Graph::get().nodesCRef())
+		{
+			SnapshotNode& copy = snapshot.emplace_back(node.pos().x, node.pos().y, node.id(), node.isCollision());
+			copy.connections.reserve(node.connections_.size());
+			for (const Node* conn : node.connections_)
+			{
+				copy.connections.push_back(conn->id());
+			}
+		}
+
+		compacting_ = true;
+		compactor_ = std::jthread([this, snapshot = std::move(snapshot), snapshotPath = snapshotPath_, rotatedPath]
+			{
+				const std::string tempPath{ snapshotPath + ".tmp" };
+				std::ofstream file(tempPath, std::ios::out | std::ios::trunc);
+
+				for (const SnapshotNode& node : snapshot)
+				{
+					std::string connections{ std::to_string(node.id) };
+					for (const int id : node.connections)
+					{
+						connections += ':' + std::to_string(id);
+					}
+
+					file << std::format("{},{},{},{},{}\n", node.x, node.y, node.id, static_cast<int>(node.collision), connections);
+				}
+
+				file.close();
+
+				//on failure the rotated journal stays, the next compaction or recovery still has every edit
+				std::error_code error;
+				if (file)
+				{
+					std::filesystem::rename(tempPath, snapshotPath, error);
+				}
+
+				if (!file || error)
+				{
+					std::filesystem::remove(tempPath, error);
+				}
+				else if (!std::filesystem::remove(rotatedPath, error) && error)
+				{
+					//the snapshot already contains these edits, replaying them over it would undo later ones
+					std::ofstream(rotatedPath, std::ios::out | std::ios::trunc);
+				}
+
+				compacting_ = false;
+			});
+
+		return true;
+	}
+
+	size_t Journal::recover(const std::string& snapshotPath)
+	{
+		replaying_ = true;
+
+		std::ifstream snapshot(snapshotPath);
+		if (snapshot.is_open())
+		{
+			Graph::get().readSnapshot(snapshot, [](const std::string& line) { Console::get().print(line); });
+		}
+		else
+		{
+			Graph::get().resetNodes();
+		}
+
+		//a rotated journal only survives when compaction did not finish, its edits are older than the live journal.
+		//The graph contains them now, so the next compaction may fold it into a fresh snapshot
+		const std::string rotatedPath{ snapshotPath + ".journal.old" };
+		std::error_code error;
+		replayedRotated_ = std::filesystem::exists(rotatedPath, error) ? rotatedPath : "";
+		size_t replayed{ replay(rotatedPath) };
+		replayed += replay(snapshotPath + ".journal");
+		Graph::get().resetIndex();
+
+		replaying_ = false;
+
+		return replayed;
+	}
+
+	void Journal::recordReset()
+	{
+		append("r\n");
+	}
+
+	void Journal::recordAddNode(const int id, const sf::Vector2f pos, const bool collision)
+	{
+		if (!isOpen() || replaying_) return;
+
+		append(std::format("n {} {} {} {}\n", id, pos.x, pos.y, static_cast<int>(collision)));
+	}
+
+	void Journal::recordMoveNode(const int id, const sf::Vector2f pos)
+	{
+		if (!isOpen() || replaying_) return;
+
+		if (lastMoveId_ == id)
+		{
+			pending_.resize(lastMoveOffset_);
+			--pendingCount_;
+		}
+
+		const size_t offset{ pending_.size() };
+		append(std::format("m {} {} {}\n", id, pos.x, pos.y));
+
+		if (!pending_.empty())
+		{
+			lastMoveOffset_ = offset;
+			lastMoveId_ = id;
+		}
+	}
+
+	void Journal::recordDeleteNode(const int id)
+	{
+		if (!isOpen() || replaying_) return;
+
+		append(std::format("d {}\n", id));
+	}
+
+	void Journal::recordAddConnection(const int id1, const int id2)
+	{
+		if (!isOpen() || replaying_) return;
+
+		append(std::format("l {} {}\n", id1, id2));
+	}
+
+	void Journal::recordDeleteConnection(const int id1, const int id2)
+	{
+		if (!isOpen() || replaying_) return;
+
+		append(std::format("u {} {}\n", id1, id2));
+	}
+
+	void Journal::recordCollision(const int id, const bool collision)
+	{
+		if (!isOpen() || replaying_) return;
+
+		append(std::format("c {} {}\n", id, static_cast<int>(collision)));
+	}
+
+	//a batch is written once it is full or its oldest entry has waited maxPendingAge_, the main loop also flushes when it goes idle
+	void Journal::append(const std::string& line)
+	{
+		if (!isOpen() || replaying_) return;
+
+		const auto now = std::chrono::steady_clock::now();
+		if (pending_.empty())
+		{
+			pendingSince_ = now;
+		}
+
+		pending_ += line;
+		lastMoveId_ = -1;
+
+		if (++pendingCount_ >= batchSize_ || now - pendingSince_ >= maxPendingAge_)
+		{
+			flush();
+		}
+	}
+
+	//moves the live journal's edits behind the rotated ones, renaming it when there is no rotated journal yet
+	bool Journal::rotate(const bool appendToRotated)
+	{
+		const std::string rotatedPath{ journalPath_ + ".old" };
+		std::error_code error;
+
+		if (!appendToRotated)
+		{
+			std::filesystem::rename(journalPath_, rotatedPath, error);
+			return !error;
+		}
+
+		std::ifstream live(journalPath_, std::ios::binary);
+		std::ofstream rotated(rotatedPath, std::ios::out | std::ios::app | std::ios::binary);
+		if (!live.is_open() || !rotated.is_open()) return false;
+
+		if (std::filesystem::file_size(journalPath_, error) > 0 && !error)
+		{
+			rotated << live.rdbuf();
+		}
+		rotated.flush();
+
+		return !error && rotated.good();
+	}
+
+	size_t Journal::replay(const std::string& journalPath)
+	{
+		std::ifstream file(journalPath);
+		if (!file.is_open()) return 0;
+
+		//entries are only order-safe: replayed in order over the snapshot they follow they rebuild the graph, Graph skips
+		//the ones that no longer apply (a node that exists already or is gone), but out of order they can undo later edits
+		size_t replayed{};
+		std::string line;
+		while (std::getline(file, line))
+		{
+			std::istringstream ss(line);
+			char operation{};
+			int id1{}, id2{};
+			float x{}, y{};
+			ss >> operation;
+
+			switch (operation)
+			{
+			case 'r':
+				Graph::get().resetNodes();
+				break;
+			case 'n':
+				if (!(ss >> id1 >> x >> y >> id2)) continue;
+				Graph::get().addNode({ x, y }, id1, id2);
+				break;
+			case 'm':
+				if (!(ss >> id1 >> x >> y)) continue;
+				Graph::get().setNodePosition(id1, { x, y });
+				break;
+			case 'd':
+				if (!(ss >> id1)) continue;
+				Graph::get().deleteNode(id1);
+				break;
+			case 'l':
+				if (!(ss >> id1 >> id2)) continue;
+				Graph::get().addIdConnection({ id1, id2 });
+				break;
+			case 'u':
+				if (!(ss >> id1 >> id2)) continue;
+				Graph::get().removeIdConnection({ id1, id2 });
+				break;
+			case 'c':
+				if (!(ss >> id1 >> id2)) continue;
+				Graph::get().setNodeCollision(id1, id2);
+				break;
+			default:
+				continue;
+			}
+
+			++replayed;
+		}
+
+		return replayed;
+	}
+}
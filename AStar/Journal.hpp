@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <chrono>
+
+
+namespace astar
+{
+	//Append-only log of graph edits, recovery is the snapshot file plus a replay of '<snapshot>.journal'
+	class Journal
+	{
+	public:
+		void operator=(const Journal&) = delete;
+		Journal(const Journal&) = delete;
+		static Journal& get();
+		bool open(const std::string& snapshotPath);
+		void close();
+		bool isOpen() const;
+		bool isCompacting() const;
+		void flush();
+		bool compact(const bool waitForRunning = false);
+		size_t recover(const std::string& snapshotPath);
+		void recordReset();
+		void recordAddNode(const int id, const sf::Vector2f pos, const bool collision);
+		void recordMoveNode(const int id, const sf::Vector2f pos);
+		void recordDeleteNode(const int id);
+		void recordAddConnection(const int id1, const int id2);
+		void recordDeleteConnection(const int id1, const int id2);
+		void recordCollision(const int id, const bool collision);
+	private:
+		struct SnapshotNode
+		{
+			float x;
+			float y;
+			int id;
+			bool collision;
+			std::vector<int> connections;
+		};
+
+		Journal();
+		~Journal();
+		void append(const std::string& line);
+		bool rotate(const bool appendToRotated);
+		size_t replay(const std::string& journalPath);
+		static constexpr size_t batchSize_{ 64 };
+		static constexpr std::chrono::seconds maxPendingAge_{ 1 };
+		std::string snapshotPath_;
+		std::string journalPath_;
+		std::ofstream file_;
+		std::string pending_;
+		size_t pendingCount_;
+		std::chrono::steady_clock::time_point pendingSince_; //when the oldest buffered entry was recorded
+		size_t lastMoveOffset_; //start of the last buffered line if it is a move, so drags collapse into one entry
+		int lastMoveId_;
+		bool replaying_;
+		std::string replayedRotated_; //rotated journal whose edits are part of the graph, empty if none
+		std::atomic<bool> compacting_;
+		std::jthread compactor_;
+	};
+}
@@ -0,0 +1,426 @@
+#include "JumpPointSearch.hpp"
+#include "Timer.hpp"
+#include <unordered_map>
+#include <queue>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+
+
+namespace
+{
+	constexpr std::array<std::pair<int, int>, 8> directions{ {
+		{ 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+		{ 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } } };
+
+	constexpr float sqrt2{ 1.41421356f };
+
+	int directionIndex(const int dx, const int dy)
+	{
+		for (int i = 0; i < std::ssize(directions); i++)
+		{
+			if (directions[i].first == dx && directions[i].second == dy)
+			{
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	int sign(const int value)
+	{
+		return (value > 0) - (value < 0);
+	}
+}
+
+namespace astar
+{
+	JumpPointSearch::JumpPointSearch() : isGrid_{}, width_{}, height_{}, spacing_{}, searchId_{}
+	{
+	}
+
+	bool JumpPointSearch::build(const std::vector<Node>& nodes, const std::vector<std::pair<int, int>>& connections)
+	{
+		const Timer timer("JumpPointSearch::build");
+
+		isGrid_ = false;
+		jumpDistances_.clear();
+
+		if (nodes.empty() || connections.empty()) return false;
+
+		std::unordered_map<int, size_t> indices;
+		indices.reserve(nodes.size());
+		float minX{ nodes.front().pos().x };
+		float minY{ nodes.front().pos().y };
+		for (size_t i = 0; i < nodes.size(); i++)
+		{
+			indices.emplace(nodes[i].id(), i);
+			minX = std::min(minX, nodes[i].pos().x);
+			minY = std::min(minY, nodes[i].pos().y);
+		}
+
+		//the shortest axis step of any edge is the lattice spacing, orthogonal edges have exactly that length
+		spacing_ = std::numeric_limits<float>::max();
+		for (const auto& [left, right] : connections)
+		{
+			const auto l = indices.find(left);
+			const auto r = indices.find(right);
+			if (l == indices.end() || r == indices.end()) return false;
+
+			const sf::Vector2f delta{ nodes[l->second].pos() - nodes[r->second].pos() };
+			spacing_ = std::min(spacing_, std::max(std::abs(delta.x), std::abs(delta.y)));
+		}
+
+		if (spacing_ <= 0.f) return false;
+
+		const float epsilon{ spacing_ * 1e-3f };
+		nodeCells_.resize(nodes.size());
+		std::vector<std::pair<int, int>> coords(nodes.size());
+		width_ = height_ = 0;
+		for (size_t i = 0; i < nodes.size(); i++)
+		{
+			const float fx{ (nodes[i].pos().x - minX) / spacing_ };
+			const float fy{ (nodes[i].pos().y - minY) / spacing_ };
+			const int x{ static_cast<int>(std::lround(fx)) };
+			const int y{ static_cast<int>(std::lround(fy)) };
+
+			if (std::abs(fx - x) * spacing_ > epsilon || std::abs(fy - y) * spacing_ > epsilon) return false;
+
+			coords[i] = { x, y };
+			width_ = std::max(width_, x + 1);
+			height_ = std::max(height_, y + 1);
+		}
+
+		//sparse lattices are not worth a dense cell array
+		if (static_cast<size_t>(width_) * height_ > nodes.size() * 8) return false;
+
+		cells_.assign(static_cast<size_t>(width_) * height_, -1);
+		walkable_.assign(cells_.size(), 0);
+		for (size_t i = 0; i < nodes.size(); i++)
+		{
+			const int cell{ coords[i].second * width_ + coords[i].first };
+			if (cells_[cell] != -1) return false;
+
+			cells_[cell] = static_cast<int>(i);
+			nodeCells_[i] = cell;
+			walkable_[cell] = !nodes[i].isCollision();
+		}
+
+		//every edge has to join lattice neighbours and every pair of lattice neighbours has to be joined
+		std::vector<uint8_t> linked(cells_.size(), 0);
+		for (const auto& [left, right] : connections)
+		{
+			const auto [lx, ly] = coords[indices[left]];
+			const auto [rx, ry] = coords[indices[right]];
+			const int direction{ directionIndex(rx - lx, ry - ly) };
+			if (direction < 0) return false;
+
+			linked[ly * width_ + lx] |= 1 << direction;
+			linked[ry * width_ + rx] |= 1 << directionIndex(lx - rx, ly - ry);
+		}
+
+		for (const auto& [x, y] : coords)
+		{
+			for (int i = 0; i < std::ssize(directions); i++)
+			{
+				const int nx{ x + directions[i].first };
+				const int ny{ y + directions[i].second };
+				const bool exists{ nx >= 0 && ny >= 0 && nx < width_ && ny < height_ && cells_[ny * width_ + nx] != -1 };
+
+				if (exists != static_cast<bool>(linked[y * width_ + x] & (1 << i))) return false;
+			}
+		}
+
+		gScore_.assign(cells_.size(), 0.f);
+		parent_.assign(cells_.size(), -1);
+		seen_.assign(cells_.size(), 0);
+		closed_.assign(cells_.size(), 0);
+		searchId_ = 0;
+
+		return isGrid_ = true;
+	}
+
+	void JumpPointSearch::precompute()
+	{
+		const Timer timer("JumpPointSearch::precompute");
+
+		jumpDistances_.assign(cells_.size(), Distances{});
+
+		const auto fill = [this](const int x, const int y, const int direction)
+			{
+				const auto [dx, dy] = directions[direction];
+				const int nx{ x + dx };
+				const int ny{ y + dy };
+				int& distance{ jumpDistances_[y * width_ + x][direction] };
+
+				if (!walkable(nx, ny))
+				{
+					distance = 0;
+					return;
+				}
+
+				const Distances& next{ jumpDistances_[ny * width_ + nx] };
+				bool jumpPoint{ hasForcedNeighbour(nx, ny, dx, dy) };
+				if (dx && dy)
+				{
+					jumpPoint = jumpPoint || next[directionIndex(dx, 0)] > 0 || next[directionIndex(0, dy)] > 0;
+				}
+
+				if (jumpPoint)
+				{
+					distance = 1;
+				}
+				else
+				{
+					distance = next[direction] > 0 ? next[direction] + 1 : next[direction] - 1;
+				}
+			};
+
+		//each direction reads the value of the next cell along it, so sweep against the direction
+		for (int direction = 0; direction < std::ssize(directions); direction++)
+		{
+			const auto [dx, dy] = directions[direction];
+
+			for (int row = 0; row < height_; row++)
+			{
+				const int y{ dy > 0 ? height_ - 1 - row : row };
+				for (int column = 0; column < width_; column++)
+				{
+					const int x{ dx > 0 ? width_ - 1 - column : column };
+					fill(x, y, direction);
+				}
+			}
+		}
+	}
+
+	bool JumpPointSearch::isGrid() const
+	{
+		return isGrid_;
+	}
+
+	std::optional<JumpPointSearch::Result> JumpPointSearch::search(const size_t startNode, const size_t endNode, const bool precomputed)
+	{
+		const Timer timer("JumpPointSearch::search");
+
+		if (!isGrid_) return std::nullopt;
+
+		if (precomputed && jumpDistances_.empty())
+		{
+			precompute();
+		}
+
+		const int start{ nodeCells_[startNode] };
+		const int goal{ nodeCells_[endNode] };
+		if (!walkable_[goal]) return std::nullopt;
+
+		if (++searchId_ == 0)
+		{
+			std::ranges::fill(seen_, 0);
+			std::ranges::fill(closed_, 0);
+			searchId_ = 1;
+		}
+
+		using Entry = std::pair<float, int>;
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> openSet;
+		gScore_[start] = 0.f;
+		parent_[start] = -1;
+		seen_[start] = searchId_;
+		openSet.emplace(heuristic(start, goal), start);
+
+		const int goalX{ goal % width_ };
+		const int goalY{ goal / width_ };
+		size_t expanded{};
+		SearchStats stats;
+		ASTAR_STAT(stats.pushes = stats.peakOpen = 1);
+
+		const auto relax = [&](const int from, const int to, const int steps, const bool diagonal)
+			{
+				const float tScore{ gScore_[from] + steps * (diagonal ? sqrt2 : 1.f) };
+				ASTAR_STAT(++stats.relaxed);
+
+				if (closed_[to] != searchId_ && (seen_[to] != searchId_ || tScore < gScore_[to]))
+				{
+					ASTAR_STAT(stats.decreaseKeys += seen_[to] == searchId_);
+					seen_[to] = searchId_;
+					gScore_[to] = tScore;
+					parent_[to] = from;
+					openSet.emplace(tScore + heuristic(to, goal), to);
+					ASTAR_STAT(++stats.pushes);
+					ASTAR_STAT(stats.peakOpen = std::max(stats.peakOpen, openSet.size()));
+				}
+			};
+
+		while (!openSet.empty())
+		{
+			const int current{ openSet.top().second };
+			openSet.pop();
+			ASTAR_STAT(++stats.pops);
+
+			if (closed_[current] == searchId_) continue;
+			closed_[current] = searchId_;
+			++expanded;
+
+			if (current == goal)
+			{
+				ASTAR_STAT(const auto reconstructionStart = std::chrono::steady_clock::now());
+				Result result{ {}, gScore_[goal] * spacing_, expanded, stats };
+
+				for (int cell = goal; parent_[cell] != -1; cell = parent_[cell])
+				{
+					const int from{ parent_[cell] };
+					const int dx{ sign(cell % width_ - from % width_) };
+					const int dy{ sign(cell / width_ - from / width_) };
+
+					for (int step = cell; step != from; step -= dy * width_ + dx)
+					{
+						result.path.push_back(cells_[step]);
+					}
+				}
+				result.path.push_back(cells_[start]);
+				std::ranges::reverse(result.path);
+				ASTAR_STAT(result.stats.reconstructionMicroseconds = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - reconstructionStart).count());
+
+				return result;
+			}
+
+			const int x{ current % width_ };
+			const int y{ current / width_ };
+
+			//natural and forced directions with respect to the direction we arrived from, all 8 at the start
+			std::array<std::pair<int, int>, 8> candidates;
+			int candidatesCount{};
+			if (parent_[current] == -1)
+			{
+				candidates = directions;
+				candidatesCount = directions.size();
+			}
+			else
+			{
+				const int dx{ sign(x - parent_[current] % width_) };
+				const int dy{ sign(y - parent_[current] / width_) };
+
+				if (dx && dy)
+				{
+					candidates[candidatesCount++] = { dx, 0 };
+					candidates[candidatesCount++] = { 0, dy };
+					candidates[candidatesCount++] = { dx, dy };
+					if (!walkable(x - dx, y)) candidates[candidatesCount++] = { -dx, dy };
+					if (!walkable(x, y - dy)) candidates[candidatesCount++] = { dx, -dy };
+				}
+				else if (dx)
+				{
+					candidates[candidatesCount++] = { dx, 0 };
+					if (!walkable(x, y + 1)) candidates[candidatesCount++] = { dx, 1 };
+					if (!walkable(x, y - 1)) candidates[candidatesCount++] = { dx, -1 };
+				}
+				else
+				{
+					candidates[candidatesCount++] = { 0, dy };
+					if (!walkable(x + 1, y)) candidates[candidatesCount++] = { 1, dy };
+					if (!walkable(x - 1, y)) candidates[candidatesCount++] = { -1, dy };
+				}
+			}
+
+			for (int i = 0; i < candidatesCount; i++)
+			{
+				const auto [dx, dy] = candidates[i];
+				const bool diagonal{ dx && dy };
+
+				if (!precomputed)
+				{
+					const int next{ diagonal ? jumpDiagonal(x, y, dx, dy, goal) : jumpStraight(x, y, dx, dy, goal) };
+					if (next != -1)
+					{
+						relax(current, next, std::max(std::abs(next % width_ - x), std::abs(next / width_ - y)), diagonal);
+					}
+					continue;
+				}
+
+				const int distance{ jumpDistances_[current][directionIndex(dx, dy)] };
+				const int reach{ std::abs(distance) };
+				const int goalDx{ goalX - x };
+				const int goalDy{ goalY - y };
+
+				//the goal is not a precomputed jump point, so stop on it or on its row or column when we pass by
+				int steps{};
+				if (!diagonal && sign(goalDx) == dx && sign(goalDy) == dy && std::abs(goalDx + goalDy) <= reach)
+				{
+					steps = std::abs(goalDx + goalDy);
+				}
+				else if (diagonal && sign(goalDx) == dx && sign(goalDy) == dy && std::min(std::abs(goalDx), std::abs(goalDy)) <= reach)
+				{
+					steps = std::min(std::abs(goalDx), std::abs(goalDy));
+				}
+				else if (distance > 0)
+				{
+					steps = distance;
+				}
+
+				if (steps > 0)
+				{
+					relax(current, (y + dy * steps) * width_ + x + dx * steps, steps, diagonal);
+				}
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	bool JumpPointSearch::walkable(const int x, const int y) const
+	{
+		return x >= 0 && y >= 0 && x < width_ && y < height_ && walkable_[y * width_ + x];
+	}
+
+	bool JumpPointSearch::hasForcedNeighbour(const int x, const int y, const int dx, const int dy) const
+	{
+		if (dx && dy)
+		{
+			return (walkable(x - dx, y + dy) && !walkable(x - dx, y)) || (walkable(x + dx, y - dy) && !walkable(x, y - dy));
+		}
+		else if (dx)
+		{
+			return (walkable(x + dx, y + 1) && !walkable(x, y + 1)) || (walkable(x + dx, y - 1) && !walkable(x, y - 1));
+		}
+
+		return (walkable(x + 1, y + dy) && !walkable(x + 1, y)) || (walkable(x - 1, y + dy) && !walkable(x - 1, y));
+	}
+
+	int JumpPointSearch::jumpStraight(int x, int y, const int dx, const int dy, const int goal) const
+	{
+		while (true)
+		{
+			x += dx;
+			y += dy;
+
+			if (!walkable(x, y)) return -1;
+
+			const int cell{ y * width_ + x };
+			if (cell == goal || hasForcedNeighbour(x, y, dx, dy)) return cell;
+		}
+	}
+
+	int JumpPointSearch::jumpDiagonal(int x, int y, const int dx, const int dy, const int goal) const
+	{
+		while (true)
+		{
+			x += dx;
+			y += dy;
+
+			if (!walkable(x, y)) return -1;
+
+			const int cell{ y * width_ + x };
+			if (cell == goal || hasForcedNeighbour(x, y, dx, dy)) return cell;
+
+			if (jumpStraight(x, y, dx, 0, goal) != -1 || jumpStraight(x, y, 0, dy, goal) != -1) return cell;
+		}
+	}
+
+	float JumpPointSearch::heuristic(const int cell, const int goal) const
+	{
+		const int dx{ std::abs(cell % width_ - goal % width_) };
+		const int dy{ std::abs(cell / width_ - goal / width_) };
+
+		return std::max(dx, dy) + (sqrt2 - 1.f) * std::min(dx, dy);
+	}
+}
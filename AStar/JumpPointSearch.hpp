@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <optional>
+#include <cstdint>
+#include "Node.hpp"
+#include "SearchStats.hpp"
+
+
+namespace astar
+{
+	//Jump Point Search over graphs whose nodes lie on a uniform lattice and are connected to all 8 lattice neighbours
+	class JumpPointSearch
+	{
+	public:
+		struct Result
+		{
+			std::vector<size_t> path; //indices into the nodes vector the grid was built from, start to end
+			float length;
+			size_t expanded;
+			SearchStats stats;
+		};
+
+		JumpPointSearch();
+		bool build(const std::vector<Node>& nodes, const std::vector<std::pair<int, int>>& connections);
+		void precompute();
+		bool isGrid() const;
+		std::optional<Result> search(const size_t startNode, const size_t endNode, const bool precomputed);
+	private:
+		using Distances = std::array<int, 8>;
+		bool walkable(const int x, const int y) const;
+		bool hasForcedNeighbour(const int x, const int y, const int dx, const int dy) const;
+		int jumpStraight(int x, int y, const int dx, const int dy, const int goal) const;
+		int jumpDiagonal(int x, int y, const int dx, const int dy, const int goal) const;
+		float heuristic(const int cell, const int goal) const;
+		bool isGrid_;
+		int width_;
+		int height_;
+		float spacing_;
+		std::vector<int> cells_; //cell -> node index, -1 for an empty lattice point
+		std::vector<int> nodeCells_; //node index -> cell
+		std::vector<uint8_t> walkable_;
+		std::vector<Distances> jumpDistances_; //JPS+ table, >0 steps to a jump point, <=0 steps to a wall
+		std::vector<float> gScore_;
+		std::vector<int> parent_;
+		std::vector<uint32_t> seen_;
+		std::vector<uint32_t> closed_;
+		uint32_t searchId_;
+	};
+}
@@ -1,6 +1,9 @@
 #include <iostream>
 
-#include "Console.hpp"
+#include "ConsoleWindow.hpp"
+#include "GraphRenderer.hpp"
+#include "JobSystem.hpp"
+#include "Journal.hpp"
 
 
 int main()
@@ -11,29 +14,63 @@ int main()
 	constexpr unsigned windowWidth{ 1270 };
 	constexpr unsigned windowHeight{ 768 };
 	sf::RenderWindow window(sf::VideoMode(windowWidth, windowHeight), "A*", sf::Style::Default, cs);
-	astar::Graph::get().setRenderTarget(&window);
+	astar::GraphRenderer::get().setRenderTarget(&window);
+	astar::GraphRenderer::registerCommands();
 	sf::View currentView{ sf::FloatRect(0, 0, windowWidth, windowHeight) };
-	astar::Console::get().resetCarriage({ 4, windowHeight - 20 });
+	astar::ConsoleWindow::get().resetCarriage({ 4, windowHeight - 20 });
 	window.setVerticalSyncEnabled(true);
 	bool movingNode{ false };
 	bool movingView{ false };
-	astar::Graph::get().setDrawIds(true);
+	astar::GraphRenderer::get().setDrawIds(true);
 	sf::Clock clk;
 	bool rapidConnect{ false };
 	float rapidConnectDelay{ 0.01f };
 	float zoom{ 1.f };
 
-	//astar::Graph::get().toggleDrawScore();
+	//astar::GraphRenderer::get().toggleDrawScore();
 	sf::Vector2f oldMousePos;
+	bool dirty{ true }; //something changed since the last frame
+	uint64_t drawnVersion{ astar::Graph::get().version() };
 
 	while (window.isOpen())
 	{
+		//results of background jobs are applied here, on the thread that owns the graph
+		if (astar::JobSystem::get().pump())
+		{
+			dirty = true;
+		}
+
+		//an animated search gets a slice of every frame until it finishes
+		if (const auto message = astar::Graph::get().advanceLiveSearch())
+		{
+			astar::Console::get().print(*message);
+			dirty = true;
+		}
+
+		//dragging, panning and rapid connect act on held buttons every frame, a running job needs its results polled,
+		//otherwise sleep until an event arrives. A server only prints now and then, it gets polled without redrawing
+		const bool continuous{ movingNode || movingView || astar::JobSystem::get().busy() || astar::Graph::get().isSearching() || (rapidConnect && sf::Mouse::isButtonPressed(sf::Mouse::Left)) };
 		sf::Event event;
+		if (!dirty && !continuous)
+		{
+			astar::Journal::get().flush(); //the loop may sleep for a long time, buffered edits shouldn't wait for it
+		}
+		bool hasEvent{ !dirty && !continuous && !astar::JobSystem::get().serving() ? window.waitEvent(event) : window.pollEvent(event) };
+		if (!hasEvent && !dirty && !continuous)
+		{
+			sf::sleep(sf::milliseconds(50));
+		}
+
 		sf::Vector2f mousePos{ sf::Mouse::getPosition(window) };
 		sf::Vector2f mousePosTranslated{ window.mapPixelToCoords(sf::Mouse::getPosition(window),currentView) };
 
-		while (window.pollEvent(event))
+		for (; hasEvent; hasEvent = window.pollEvent(event))
 		{
+			if (event.type != sf::Event::MouseMoved || astar::GraphRenderer::get().tracksMouse())
+			{
+				dirty = true;
+			}
+
 			if (movingNode)
 			{
 				if (event.type == sf::Event::MouseButtonReleased)
@@ -57,23 +94,23 @@ int main()
 				currentView = sf::View(sf::FloatRect(0, 0, static_cast<float>(event.size.width), static_cast<float>(event.size.height)));
 				zoom = 1.f;
 				window.setView(currentView);
-				astar::Console::get().resetCarriage({ 4, static_cast<float>(event.size.height) });
+				astar::ConsoleWindow::get().resetCarriage({ 4, static_cast<float>(event.size.height) });
 				break;
 			case sf::Event::TextEntered:
-				if (astar::Console::get().isOpen())
+				if (astar::ConsoleWindow::get().isOpen())
 				{
 #ifdef _DEBUG
 					std::cout << "key pressed: " << event.key.code << '\n';
 #endif
-					astar::Console::get().addChar(event.text.unicode);
-					astar::Console::get().handleInput(event.key.code);
+					astar::ConsoleWindow::get().addChar(event.text.unicode);
+					astar::ConsoleWindow::get().handleInput(event.key.code);
 				}
 			break;
 			case sf::Event::KeyPressed:
 				switch (event.key.code)
 				{
 				case sf::Keyboard::Tilde:
-					astar::Console::get().toggle();
+					astar::ConsoleWindow::get().toggle();
 					break;
 				case sf::Keyboard::Escape:
 					window.close();
@@ -82,13 +119,13 @@ int main()
 					astar::Graph::get().selectNodes(mousePosTranslated);
 					break;
 				case sf::Keyboard::O:
-					astar::Graph::get().increaseOffset(1);
+					astar::GraphRenderer::get().increaseOffset(1);
 					break;
 				case sf::Keyboard::C:
 					astar::Graph::get().clearSavedNode();
 					break;
 				case sf::Keyboard::P:
-					astar::Graph::get().increaseOffset(-1);
+					astar::GraphRenderer::get().increaseOffset(-1);
 					break;
 				case sf::Keyboard::V:
 					astar::Graph::get().toggleRapidConnect();
@@ -101,10 +138,12 @@ int main()
 					astar::Graph::get().setCollision(mousePosTranslated);
 					break;
 				case sf::Keyboard::Left:
-					astar::Console::get().moveCarriage(true);
+					astar::ConsoleWindow::get().moveCarriage(true);
 					break;
 				case sf::Keyboard::Right:
-					astar::Console::get().moveCarriage(false);
+					astar::ConsoleWindow::get().moveCarriage(false);
+					break;
+				default:
 					break;
 				}
 				break;
@@ -138,6 +177,8 @@ int main()
 						astar::Graph::get().checkAndDelete(mousePosTranslated);
 					}
 					break;
+				default:
+					break;
 				}
 				break;
 			case sf::Event::MouseWheelScrolled:
@@ -146,11 +187,14 @@ int main()
 					zoom *= 0.9f;
 					currentView.zoom(0.9f);
 				}
-				else if(event.mouseWheelScroll.delta == -1 && zoom < 10.f)
+				else if(event.mouseWheelScroll.delta == -1 && zoom < 1000.f)
 				{
 					zoom *= 1.1f;
 					currentView.zoom(1.1f);
 				}
+				break;
+			default:
+				break;
 			}
 		}
 
@@ -174,12 +218,20 @@ int main()
 		}
 
 		oldMousePos = mousePos;
+
+		if (!dirty && !continuous && !movingView && astar::Graph::get().version() == drawnVersion)
+		{
+			continue;
+		}
+
 		window.setView(currentView);
 		window.clear();
-		astar::Graph::get().draw(mousePosTranslated);
+		astar::GraphRenderer::get().draw(mousePosTranslated);
 		window.setView(sf::View(sf::FloatRect(0, 0, static_cast<float>(window.getSize().x), static_cast<float>(window.getSize().y))));
-		astar::Console::get().draw(window);
-		astar::Graph::get().drawStats();
+		astar::ConsoleWindow::get().draw(window);
+		astar::GraphRenderer::get().drawStats();
 		window.display();
+		dirty = false;
+		drawnVersion = astar::Graph::get().version();
 	}
 }
@@ -2,23 +2,16 @@
 #include <iostream>
 #include <format>
 #include "Graph.hpp"
+#include "Utils.hpp"
 
 namespace astar
 {
-	Node::Node() : id_{}, isCollision_{}, gScore_{}, fScore_{}, parent_{}
+	Node::Node() : mark_{ Mark::None }, id_{}, isCollision_{}
 	{
 	}
 
-	Node::Node(const float x, const float y, const int id, const bool collision) : isCollision_{ collision }, connections_{}, id_{ id }, gScore_{ std::numeric_limits<float>::max() }, fScore_{ std::numeric_limits<float>::max() }, parent_{ nullptr }
+	Node::Node(const float x, const float y, const int id, const bool collision) : connections_{}, mark_{ Mark::None }, pos_{ x, y }, id_{ id }, isCollision_{ collision }
 	{
-		circle_.setPosition(x, y);
-		circle_.setRadius(radius_);
-		circle_.setOrigin(radius_, radius_);
-		circle_.setFillColor(sf::Color::Green);
-		circle_.setOutlineColor(collision ? sf::Color::Red : sf::Color::White);
-		circle_.setOutlineThickness(border_);
-		connections_.reserve(100);
-
 #ifdef _DEBUG
 		std::cout << std::format("Creating node at ({},{}) with id {} and collision {}\n", x, y, id, collision ? "on" : "off");
 #endif
@@ -26,12 +19,12 @@ namespace astar
 
 	void Node::changePos(const sf::Vector2f& mousePos)
 	{
-		circle_.setPosition(mousePos.x, mousePos.y);
+		pos_ = mousePos;
 	}
 
 	sf::Vector2f Node::pos() const
 	{
-		return circle_.getPosition();
+		return pos_;
 	}
 
 	bool Node::isMouseOver(const sf::Vector2f& mousePos) const
@@ -41,7 +34,7 @@ namespace astar
 
 	float Node::distanceFromMouse(const sf::Vector2f mousePos) const
 	{
-		return std::sqrtf(std::powf(mousePos.x - circle_.getPosition().x, 2) + std::powf(mousePos.y - circle_.getPosition().y, 2));
+		return utils::euclidDistance(mousePos, pos_);
 	}
 
 	int Node::id() const
@@ -51,7 +44,8 @@ namespace astar
 
 	void Node::toggleCollision()
 	{
-		circle_.setOutlineColor((isCollision_ = !isCollision_) ? sf::Color::Red : sf::Color::White);
+		isCollision_ = !isCollision_;
+		mark_ = Mark::None;
 	}
 
 	bool Node::isCollision() const
@@ -66,7 +60,8 @@ namespace astar
 			id_ = other.id_;
 			connections_ = other.connections_;
 			isCollision_ = other.isCollision_;
-			circle_ = other.circle_;
+			pos_ = other.pos_;
+			mark_ = other.mark_;
 		}
 		return *this;
 	}
@@ -78,7 +73,8 @@ namespace astar
 			id_ = std::move(other.id_);
 			connections_ = std::move(other.connections_);
 			isCollision_ = std::move(other.isCollision_);
-			circle_ = std::move(other.circle_);
+			pos_ = other.pos_;
+			mark_ = other.mark_;
 		}
 		return *this;
 	}
@@ -1,6 +1,7 @@
 #pragma once
 
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
 #include "Connection.hpp"
 
 namespace astar
@@ -20,15 +21,13 @@ namespace astar
 		static constexpr float radius_{ 26.f };
 		static constexpr float border_{ 4.f };
 		std::vector<Node*> connections_;
-		sf::CircleShape circle_;
+		Mark mark_;
 		void changePos(const sf::Vector2f& mousePos);
 		Node& operator=(const Node& other);
 		Node& operator=(Node&& other) noexcept;
-		float gScore_;
-		float fScore_;
-		Node* parent_;
 
 	private:
+		sf::Vector2f pos_;
 		int id_;
 		bool isCollision_;
 	};
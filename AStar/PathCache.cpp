@@ -0,0 +1,126 @@
+#include "PathCache.hpp"
+
+
+namespace astar
+{
+	std::optional<SearchEngine> engineFromString(const std::string_view name)
+	{
+		if (name == "astar") return SearchEngine::AStar;
+		if (name == "jps") return SearchEngine::Jps;
+		if (name == "jps+") return SearchEngine::JpsPlus;
+
+		return std::nullopt;
+	}
+
+	std::string_view engineName(const SearchEngine engine)
+	{
+		switch (engine)
+		{
+		case SearchEngine::Jps:
+			return "jps";
+		case SearchEngine::JpsPlus:
+			return "jps+";
+		default:
+			return "astar";
+		}
+	}
+
+	PathCache::PathCache(const size_t capacity) : capacity_{ capacity }, hits_{}, misses_{}
+	{
+		index_.reserve(capacity);
+	}
+
+	std::shared_ptr<const PathResult> PathCache::find(const int start, const int end, const SearchEngine engine, const uint64_t version)
+	{
+		const auto found = index_.find({ start, end, engine });
+
+		if (found == index_.end())
+		{
+			++misses_;
+			return nullptr;
+		}
+
+		if (found->second->version != version)
+		{
+			entries_.erase(found->second);
+			index_.erase(found);
+			++misses_;
+			return nullptr;
+		}
+
+		entries_.splice(entries_.begin(), entries_, found->second);
+		++hits_;
+		return found->second->result;
+	}
+
+	void PathCache::insert(const int start, const int end, const SearchEngine engine, const uint64_t version, std::shared_ptr<const PathResult> result)
+	{
+		if (capacity_ == 0) return;
+
+		const Key key{ start, end, engine };
+		if (const auto found = index_.find(key); found != index_.end())
+		{
+			found->second->version = version;
+			found->second->result = std::move(result);
+			entries_.splice(entries_.begin(), entries_, found->second);
+			return;
+		}
+
+		entries_.push_front({ key, version, std::move(result) });
+		index_.emplace(key, entries_.begin());
+		evict();
+	}
+
+	void PathCache::clear()
+	{
+		entries_.clear();
+		index_.clear();
+		hits_ = misses_ = 0;
+	}
+
+	void PathCache::setCapacity(const size_t capacity)
+	{
+		capacity_ = capacity;
+		evict();
+	}
+
+	size_t PathCache::capacity() const
+	{
+		return capacity_;
+	}
+
+	size_t PathCache::size() const
+	{
+		return entries_.size();
+	}
+
+	size_t PathCache::hits() const
+	{
+		return hits_;
+	}
+
+	size_t PathCache::misses() const
+	{
+		return misses_;
+	}
+
+	float PathCache::hitRate() const
+	{
+		return hits_ + misses_ ? static_cast<float>(hits_) / (hits_ + misses_) : 0.f;
+	}
+
+	size_t PathCache::KeyHash::operator()(const Key& key) const
+	{
+		const uint64_t packed{ (static_cast<uint64_t>(static_cast<uint32_t>(key.start)) << 32) | static_cast<uint32_t>(key.end) };
+		return std::hash<uint64_t>{}(packed * 0x9E3779B97F4A7C15ull + static_cast<uint64_t>(key.engine));
+	}
+
+	void PathCache::evict()
+	{
+		while (entries_.size() > capacity_)
+		{
+			index_.erase(entries_.back().key);
+			entries_.pop_back();
+		}
+	}
+}
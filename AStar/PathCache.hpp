@@ -0,0 +1,76 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include "SearchStats.hpp"
+
+
+namespace astar
+{
+	enum class SearchEngine
+	{
+		AStar,
+		Jps,
+		JpsPlus
+	};
+
+	std::optional<SearchEngine> engineFromString(const std::string_view name);
+	std::string_view engineName(const SearchEngine engine);
+
+	struct PathResult
+	{
+		bool found;
+		float length;
+		size_t expanded;
+		std::vector<int> path; //node ids, start to end
+		SearchStats stats{};
+	};
+
+	//Bounded LRU of search results, an entry is only valid for the graph version it was computed on
+	class PathCache
+	{
+	public:
+		explicit PathCache(const size_t capacity = 1024);
+		std::shared_ptr<const PathResult> find(const int start, const int end, const SearchEngine engine, const uint64_t version);
+		void insert(const int start, const int end, const SearchEngine engine, const uint64_t version, std::shared_ptr<const PathResult> result);
+		void clear();
+		void setCapacity(const size_t capacity);
+		size_t capacity() const;
+		size_t size() const;
+		size_t hits() const;
+		size_t misses() const;
+		float hitRate() const;
+	private:
+		struct Key
+		{
+			int start;
+			int end;
+			SearchEngine engine;
+			bool operator==(const Key&) const = default;
+		};
+
+		struct KeyHash
+		{
+			size_t operator()(const Key& key) const;
+		};
+
+		struct Entry
+		{
+			Key key;
+			uint64_t version;
+			std::shared_ptr<const PathResult> result;
+		};
+
+		void evict();
+		size_t capacity_;
+		size_t hits_;
+		size_t misses_;
+		std::list<Entry> entries_; //most recently used at the front
+		std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+	};
+}
@@ -0,0 +1,323 @@
+#include "QueryServer.hpp"
+#include "Graph.hpp"
+#include "JobSystem.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <limits>
+#include <memory>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+
+namespace
+{
+#ifdef _WIN32
+	using Socket = SOCKET;
+	constexpr Socket invalidSocket{ INVALID_SOCKET };
+	constexpr int noSignal{ 0 };
+
+	void closeSocket(const Socket socket)
+	{
+		closesocket(socket);
+	}
+
+	int pollSocket(const Socket socket, const int timeoutMs)
+	{
+		WSAPOLLFD fd{ socket, POLLRDNORM, 0 };
+		return WSAPoll(&fd, 1, timeoutMs);
+	}
+#else
+	using Socket = int;
+	constexpr Socket invalidSocket{ -1 };
+	constexpr int noSignal{ MSG_NOSIGNAL };
+
+	void closeSocket(const Socket socket)
+	{
+		close(socket);
+	}
+
+	int pollSocket(const Socket socket, const int timeoutMs)
+	{
+		pollfd fd{ socket, POLLIN, 0 };
+		return poll(&fd, 1, timeoutMs);
+	}
+#endif
+
+	constexpr int pollIntervalMs{ 100 }; //how quickly blocked threads notice a stop request
+
+	//waits for data in short slices so a cancelled job is noticed, false once the peer is gone or stop was requested
+	bool receiveAll(const Socket socket, char* data, size_t size, const astar::JobContext& job)
+	{
+		while (size > 0)
+		{
+			if (job.stopRequested()) return false;
+
+			const int ready{ pollSocket(socket, pollIntervalMs) };
+			if (ready < 0) return false;
+			if (ready == 0) continue;
+
+			const int received{ static_cast<int>(recv(socket, data, static_cast<int>(std::min<size_t>(size, 1 << 20)), 0)) };
+			if (received <= 0) return false;
+
+			data += received;
+			size -= received;
+		}
+
+		return true;
+	}
+
+	bool sendAll(const Socket socket, const char* data, size_t size)
+	{
+		while (size > 0)
+		{
+			const int sent{ static_cast<int>(send(socket, data, static_cast<int>(std::min<size_t>(size, 1 << 20)), noSignal)) };
+			if (sent <= 0) return false;
+
+			data += sent;
+			size -= sent;
+		}
+
+		return true;
+	}
+
+	template<typename T>
+	void append(std::vector<char>& buffer, const T value)
+	{
+		const size_t size{ buffer.size() };
+		buffer.resize(size + sizeof(T));
+		std::memcpy(buffer.data() + size, &value, sizeof(T));
+	}
+}
+
+namespace astar
+{
+	QueryServer::QueryServer(const Graph& graph, const unsigned int threads)
+	{
+		graph_.build(graph.nodesCRef());
+		for (uint32_t i = 0; i < graph_.size(); i++)
+		{
+			index_.emplace(graph_.ids[i], i);
+		}
+
+		for (unsigned int i = 0; i < std::max(threads, 1u); i++)
+		{
+			workers_.emplace_back([this](std::stop_token stop) { work(stop); });
+		}
+	}
+
+	size_t QueryServer::nodeCount() const
+	{
+		return graph_.size();
+	}
+
+	void QueryServer::serve(const std::string& socketPath, JobContext& job)
+	{
+#ifdef _WIN32
+		static const bool started{ [] { WSADATA data; return WSAStartup(MAKEWORD(2, 2), &data) == 0; }() };
+		if (!started)
+		{
+			job.print("&&Rcan't initialize sockets!");
+			return;
+		}
+#endif
+
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (socketPath.size() >= sizeof(address.sun_path))
+		{
+			job.print("&&Rsocket path '" + socketPath + "' is too long!");
+			return;
+		}
+		std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+		std::error_code error;
+		std::filesystem::remove(socketPath, error);
+
+		const Socket listener{ socket(AF_UNIX, SOCK_STREAM, 0) };
+		if (listener == invalidSocket || bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0)
+		{
+			if (listener != invalidSocket)
+			{
+				closeSocket(listener);
+			}
+			job.print("&&Rcan't listen on socket '" + socketPath + "'!");
+			return;
+		}
+
+		job.print(std::format("&&Gserving {} nodes on '{}' with {} threads, 'cancel' stops the server", graph_.size(), socketPath, workers_.size()));
+
+		{
+			//threads of closed connections are joined at the next poll, so only the open ones are kept
+			std::vector<std::unique_ptr<Connection>> connections;
+			while (!job.stopRequested())
+			{
+				std::erase_if(connections, [](const std::unique_ptr<Connection>& connection) { return connection->closed.load(std::memory_order_acquire); });
+
+				if (pollSocket(listener, pollIntervalMs) <= 0) continue;
+
+				const Socket socket{ accept(listener, nullptr, nullptr) };
+				if (socket == invalidSocket) continue;
+
+				Connection& connection = *connections.emplace_back(std::make_unique<Connection>());
+				connection.thread = std::jthread([this, socket, &job, &closed = connection.closed]
+					{
+						handleConnection(static_cast<uintptr_t>(socket), job);
+						closed.store(true, std::memory_order_release);
+					});
+			}
+		}
+
+		closeSocket(listener);
+		std::filesystem::remove(socketPath, error);
+
+		std::scoped_lock lock(mutex_);
+		job.print("&&Gserver stopped, " + describe(total_));
+	}
+
+	void QueryServer::work(std::stop_token stop)
+	{
+		SearchScratch scratch;
+
+		while (true)
+		{
+			Task task;
+			{
+				std::unique_lock lock(mutex_);
+				if (!wake_.wait(lock, stop, [this] { return !tasks_.empty(); })) return;
+
+				task = tasks_.front();
+				tasks_.pop_front();
+			}
+
+			solve(*task.query, *task.answer, scratch, task.deadline);
+			task.done->count_down();
+		}
+	}
+
+	//gives up at the deadline, a query can't hold a worker longer than its request's budget
+	void QueryServer::solve(const Query& query, Answer& answer, SearchScratch& scratch, const std::chrono::steady_clock::time_point deadline) const
+	{
+		answer.status = Status::NoPath;
+		answer.length = 0.f;
+		answer.path.clear();
+
+		if (std::chrono::steady_clock::now() >= deadline)
+		{
+			answer.status = Status::TimedOut;
+			return;
+		}
+
+		const auto start = index_.find(query.start);
+		const auto end = index_.find(query.end);
+		if (start == index_.end() || end == index_.end()) return;
+
+		AStarSearch search(graph_, scratch, start->second, end->second);
+		const auto state = search.step(std::numeric_limits<size_t>::max(), deadline);
+		if (state == AStarSearch::State::Running)
+		{
+			answer.status = Status::TimedOut;
+		}
+		else if (state == AStarSearch::State::Found)
+		{
+			answer.status = Status::Found;
+			answer.length = search.length();
+			answer.path.assign(search.path().begin(), search.path().end());
+		}
+	}
+
+	//frames are answered strictly in order, the queries of one frame are spread over the worker pool
+	void QueryServer::handleConnection(const uintptr_t connection, JobContext& job)
+	{
+		const Socket socket{ static_cast<Socket>(connection) };
+		Latencies latencies;
+		std::vector<char> frame;
+		std::vector<Query> queries;
+		std::vector<Answer> answers;
+		std::vector<char> response;
+
+		while (true)
+		{
+			uint32_t size;
+			if (!receiveAll(socket, reinterpret_cast<char*>(&size), sizeof(size), job)) break;
+
+			if (size < sizeof(uint32_t) || size > maxFrameSize_)
+			{
+				job.print(std::format("&&Rdropping connection, bad frame size {}", size));
+				break;
+			}
+
+			frame.resize(size);
+			if (!receiveAll(socket, frame.data(), size, job)) break;
+
+			const auto received = std::chrono::steady_clock::now();
+			uint32_t count;
+			std::memcpy(&count, frame.data(), sizeof(count));
+			if (count > (size - sizeof(uint32_t)) / sizeof(Query) || size != sizeof(uint32_t) + count * sizeof(Query))
+			{
+				job.print(std::format("&&Rdropping connection, frame of {} bytes can't hold {} queries", size, count));
+				break;
+			}
+
+			queries.resize(count);
+			std::memcpy(queries.data(), frame.data() + sizeof(uint32_t), count * sizeof(Query));
+			answers.resize(count);
+
+			std::latch done(count);
+			{
+				std::scoped_lock lock(mutex_);
+				for (uint32_t i = 0; i < count; i++)
+				{
+					tasks_.push_back({ &queries[i], &answers[i], &done, received + requestBudget_ });
+				}
+			}
+			wake_.notify_all();
+			done.wait();
+
+			response.assign(sizeof(uint32_t), 0);
+			for (const Answer& answer : answers)
+			{
+				append<uint8_t>(response, static_cast<uint8_t>(answer.status));
+				append<float>(response, answer.length);
+				append<uint32_t>(response, static_cast<uint32_t>(answer.path.size()));
+				for (const int32_t id : answer.path)
+				{
+					append<int32_t>(response, id);
+				}
+			}
+			const uint32_t responseSize{ static_cast<uint32_t>(response.size() - sizeof(uint32_t)) };
+			std::memcpy(response.data(), &responseSize, sizeof(responseSize));
+
+			if (!sendAll(socket, response.data(), response.size())) break;
+
+			latencies.microseconds.push_back(std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - received).count());
+			latencies.queries += count;
+		}
+
+		closeSocket(socket);
+
+		std::scoped_lock lock(mutex_);
+		total_.microseconds.insert(total_.microseconds.end(), latencies.microseconds.begin(), latencies.microseconds.end());
+		total_.queries += latencies.queries;
+		job.print("&&Gconnection closed, " + describe(std::move(latencies)));
+	}
+
+	std::string QueryServer::describe(Latencies latencies) const
+	{
+		std::ranges::sort(latencies.microseconds);
+		return std::format("{} requests, {} queries, request latency p50 {:.1f}us p99 {:.1f}us", latencies.microseconds.size(), latencies.queries,
+			utils::percentile(latencies.microseconds, 0.5f), utils::percentile(latencies.microseconds, 0.99f));
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <latch>
+#include <atomic>
+#include <unordered_map>
+#include <cstdint>
+#include <chrono>
+#include "AStarSearch.hpp"
+
+
+namespace astar
+{
+	class Graph;
+	class JobContext;
+
+	//Answers A* queries from other processes over a Unix domain socket, against a read-only copy of the graph.
+	//All integers are little endian, every frame starts with the uint32 byte length of what follows:
+	//  request:  uint32 count, then count pairs of int32 start id and int32 end id
+	//  response: per query uint8 status, float length, uint32 path size, then path size int32 node ids
+	//Status is 0 when there is no path, 1 when one was found and 2 when the request ran out of time first, the queries
+	//of one request share requestBudget_ from the moment it was received, a timed out query has an empty path.
+	//A connection may send any number of requests without waiting, responses come back in the same order
+	class QueryServer
+	{
+	public:
+		struct Query
+		{
+			int32_t start;
+			int32_t end;
+		};
+
+		enum class Status : uint8_t
+		{
+			NoPath,
+			Found,
+			TimedOut
+		};
+
+		struct Answer
+		{
+			Status status;
+			float length;
+			std::vector<int32_t> path;
+		};
+
+		QueryServer(const Graph& graph, const unsigned int threads);
+		size_t nodeCount() const;
+		void serve(const std::string& socketPath, JobContext& job);
+	private:
+		struct Task
+		{
+			const Query* query;
+			Answer* answer;
+			std::latch* done;
+			std::chrono::steady_clock::time_point deadline;
+		};
+
+		struct Latencies
+		{
+			std::vector<float> microseconds;
+			size_t queries{};
+		};
+
+		struct Connection
+		{
+			std::atomic<bool> closed{}; //set by the thread as its last step, declared first so the thread is joined before it goes
+			std::jthread thread;
+		};
+
+		void work(std::stop_token stop);
+		void solve(const Query& query, Answer& answer, SearchScratch& scratch, const std::chrono::steady_clock::time_point deadline) const;
+		void handleConnection(const uintptr_t connection, JobContext& job);
+		std::string describe(Latencies latencies) const;
+		static constexpr uint32_t maxFrameSize_{ 64 * 1024 * 1024 };
+		static constexpr std::chrono::milliseconds requestBudget_{ 500 };
+		SearchGraph graph_;
+		std::unordered_map<int32_t, uint32_t> index_; //node id -> index in graph_
+		std::mutex mutex_;
+		std::condition_variable_any wake_;
+		std::deque<Task> tasks_;
+		Latencies total_;
+		std::vector<std::jthread> workers_;
+	};
+}
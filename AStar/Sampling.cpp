@@ -0,0 +1,181 @@
+#include "Sampling.hpp"
+#include <unordered_map>
+#include <numbers>
+#include <cmath>
+#include <algorithm>
+
+
+namespace
+{
+	constexpr int candidatesPerPoint{ 30 };
+	constexpr int maxTries{ 10000 };
+
+	//a single cell of side minDistance / sqrt(2) can never hold two points
+	float cellSize(const float minDistance)
+	{
+		return minDistance / std::numbers::sqrt2_v<float>;
+	}
+
+	//Bridson's maximal sets reach roughly 70% of the hexagonal packing density
+	double estimatedCapacity(const float radius, const float minDistance)
+	{
+		return 0.7 * std::numbers::pi * radius * radius / (std::numbers::sqrt3 / 2. * minDistance * minDistance);
+	}
+
+	sf::Vector2f pointInDisk(const float radius, std::mt19937_64& mt)
+	{
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+		const float r{ radius * std::sqrt(unit(mt)) };
+		const float angle{ 2.f * std::numbers::pi_v<float> * unit(mt) };
+
+		return { r * std::cos(angle), r * std::sin(angle) };
+	}
+
+	bool tooClose(const sf::Vector2f left, const sf::Vector2f right, const float minDistance)
+	{
+		const sf::Vector2f delta{ left - right };
+		return delta.x * delta.x + delta.y * delta.y <= minDistance * minDistance;
+	}
+
+	//Bridson's algorithm over a dense background grid, grows a maximal set from one seed
+	std::vector<sf::Vector2f> bridson(const float radius, const float minDistance, std::mt19937_64& mt)
+	{
+		const float cell{ cellSize(minDistance) };
+		const int side{ static_cast<int>(std::ceil(2.f * radius / cell)) + 1 };
+		std::vector<int> grid(static_cast<size_t>(side) * side, -1);
+		std::vector<sf::Vector2f> points;
+		std::vector<int> active;
+
+		const auto cellOf = [&](const sf::Vector2f pos)
+			{
+				return std::pair{ std::clamp(static_cast<int>((pos.x + radius) / cell), 0, side - 1),
+								  std::clamp(static_cast<int>((pos.y + radius) / cell), 0, side - 1) };
+			};
+
+		const auto fits = [&](const sf::Vector2f pos)
+			{
+				if (pos.x * pos.x + pos.y * pos.y > radius * radius) return false;
+
+				const auto [cx, cy] = cellOf(pos);
+				for (int y = std::max(cy - 2, 0); y <= std::min(cy + 2, side - 1); y++)
+				{
+					for (int x = std::max(cx - 2, 0); x <= std::min(cx + 2, side - 1); x++)
+					{
+						const int index{ grid[y * side + x] };
+						if (index >= 0 && tooClose(points[index], pos, minDistance)) return false;
+					}
+				}
+
+				return true;
+			};
+
+		const auto add = [&](const sf::Vector2f pos)
+			{
+				const auto [cx, cy] = cellOf(pos);
+				grid[cy * side + cx] = static_cast<int>(points.size());
+				active.push_back(static_cast<int>(points.size()));
+				points.push_back(pos);
+			};
+
+		add(pointInDisk(radius, mt));
+
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+		while (!active.empty())
+		{
+			const size_t i{ std::uniform_int_distribution<size_t>(0, active.size() - 1)(mt) };
+			const sf::Vector2f origin{ points[active[i]] };
+
+			bool found{ false };
+			for (int k = 0; k < candidatesPerPoint && !found; k++)
+			{
+				const float angle{ 2.f * std::numbers::pi_v<float> * unit(mt) };
+				const float distance{ minDistance * (1.f + unit(mt)) };
+				const sf::Vector2f candidate{ origin.x + distance * std::cos(angle), origin.y + distance * std::sin(angle) };
+
+				if (fits(candidate))
+				{
+					add(candidate);
+					found = true;
+				}
+			}
+
+			if (!found)
+			{
+				active[i] = active.back();
+				active.pop_back();
+			}
+		}
+
+		return points;
+	}
+
+	//uniform dart throwing against a hashed grid, for disks far too big for the requested count to fill
+	std::vector<sf::Vector2f> dartThrowing(const int count, const float radius, const float minDistance, std::mt19937_64& mt)
+	{
+		const float cell{ cellSize(minDistance) };
+		std::unordered_map<long long, int> grid;
+		grid.reserve(count * 2);
+		std::vector<sf::Vector2f> points;
+		points.reserve(count);
+
+		const auto key = [](const int x, const int y) { return (static_cast<long long>(x) << 32) ^ static_cast<unsigned int>(y); };
+
+		for (int i = 0; i < count; i++)
+		{
+			bool placed{ false };
+			for (int tries = 0; tries < maxTries && !placed; tries++)
+			{
+				const sf::Vector2f pos{ pointInDisk(radius, mt) };
+				const int cx{ static_cast<int>(std::floor((pos.x + radius) / cell)) };
+				const int cy{ static_cast<int>(std::floor((pos.y + radius) / cell)) };
+
+				bool valid{ true };
+				for (int y = cy - 2; y <= cy + 2 && valid; y++)
+				{
+					for (int x = cx - 2; x <= cx + 2 && valid; x++)
+					{
+						const auto found = grid.find(key(x, y));
+						valid = found == grid.end() || !tooClose(points[found->second], pos, minDistance);
+					}
+				}
+
+				if (valid)
+				{
+					grid.emplace(key(cx, cy), static_cast<int>(points.size()));
+					points.push_back(pos);
+					placed = true;
+				}
+			}
+
+			if (!placed) break;
+		}
+
+		return points;
+	}
+}
+
+namespace astar::sampling
+{
+	std::vector<sf::Vector2f> poissonDisk(const int count, const float radius, const float minDistance, std::mt19937_64& mt)
+	{
+		if (count <= 0 || radius <= 0.f) return {};
+
+		//the dense grid costs memory proportional to the disk area, only worth it when the count fills a good part of it
+		if (estimatedCapacity(radius, minDistance) >= 4. * count)
+		{
+			return dartThrowing(count, radius, minDistance, mt);
+		}
+
+		std::vector<sf::Vector2f> points{ bridson(radius, minDistance, mt) };
+
+		//Bridson grows outwards from the seed, pick a random subset so the nodes are spread over the whole disk
+		const size_t kept{ std::min(points.size(), static_cast<size_t>(count)) };
+		for (size_t i = 0; i < kept; i++)
+		{
+			std::swap(points[i], points[std::uniform_int_distribution<size_t>(i, points.size() - 1)(mt)]);
+		}
+		points.resize(kept);
+
+		return points;
+	}
+}
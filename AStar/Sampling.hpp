@@ -0,0 +1,13 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <random>
+
+
+namespace astar::sampling
+{
+	//Up to count points inside the disk of the given radius around the origin, no two of them within minDistance.
+	//Returns fewer points only when the disk is full.
+	std::vector<sf::Vector2f> poissonDisk(const int count, const float radius, const float minDistance, std::mt19937_64& mt);
+}
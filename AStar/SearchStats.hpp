@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <format>
+
+//Search counters are on in debug builds and compiled out of release builds unless ASTAR_SEARCH_STATS is defined to 1
+#ifndef ASTAR_SEARCH_STATS
+#ifdef NDEBUG
+#define ASTAR_SEARCH_STATS 0
+#else
+#define ASTAR_SEARCH_STATS 1
+#endif
+#endif
+
+#if ASTAR_SEARCH_STATS
+#define ASTAR_STAT(...) __VA_ARGS__
+#else
+#define ASTAR_STAT(...)
+#endif
+
+
+namespace astar
+{
+	//What one search did beyond expanding nodes, the expanded count itself is always kept in PathResult
+	struct SearchStats
+	{
+		static constexpr bool enabled{ ASTAR_SEARCH_STATS != 0 };
+		size_t relaxed{}; //edges looked at from expanded nodes
+		size_t pushes{};
+		size_t decreaseKeys{}; //pushes that improved a node already in the open set, the old entry goes stale
+		size_t pops{}; //stale entries included
+		size_t peakOpen{};
+		float reconstructionMicroseconds{};
+
+		//sums a benchmark, peakOpen keeps the largest
+		SearchStats& operator+=(const SearchStats& other)
+		{
+			relaxed += other.relaxed;
+			pushes += other.pushes;
+			decreaseKeys += other.decreaseKeys;
+			pops += other.pops;
+			peakOpen = std::max(peakOpen, other.peakOpen);
+			reconstructionMicroseconds += other.reconstructionMicroseconds;
+			return *this;
+		}
+
+		std::string describe() const
+		{
+			return std::format("relaxed: {}, pushes: {}, decrease keys: {}, pops: {}, peak open: {}, reconstruction: {:.1f}us",
+				relaxed, pushes, decreaseKeys, pops, peakOpen, reconstructionMicroseconds);
+		}
+	};
+}
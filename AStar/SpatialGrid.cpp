@@ -0,0 +1,134 @@
+#include "SpatialGrid.hpp"
+#include <queue>
+#include <limits>
+
+
+namespace astar
+{
+	SpatialGrid::SpatialGrid() : cellSize_{ 1.f }, width_{}, height_{}
+	{
+	}
+
+	void SpatialGrid::build(const std::vector<sf::Vector2f>& points, const float cellSize)
+	{
+		clear();
+		if (points.empty()) return;
+
+		points_ = points;
+		sf::Vector2f min{ points.front() };
+		sf::Vector2f max{ points.front() };
+		for (const sf::Vector2f point : points)
+		{
+			min = { std::min(min.x, point.x), std::min(min.y, point.y) };
+			max = { std::max(max.x, point.x), std::max(max.y, point.y) };
+		}
+
+		//never let the cell array grow past a few cells per point, whatever the requested size
+		const float extent{ std::max(max.x - min.x, max.y - min.y) };
+		cellSize_ = std::max({ cellSize, extent / std::sqrt(4.f * points.size()), 1e-3f });
+		origin_ = min;
+		width_ = cellX(max.x) + 1;
+		height_ = cellY(max.y) + 1;
+
+		cellStart_.assign(static_cast<size_t>(width_) * height_ + 1, 0);
+		for (const sf::Vector2f point : points)
+		{
+			++cellStart_[cellY(point.y) * width_ + cellX(point.x) + 1];
+		}
+
+		for (size_t i = 1; i < cellStart_.size(); i++)
+		{
+			cellStart_[i] += cellStart_[i - 1];
+		}
+
+		items_.resize(points.size());
+		std::vector<int> fill(cellStart_.begin(), cellStart_.end() - 1);
+		for (int i = 0; i < std::ssize(points); i++)
+		{
+			items_[fill[cellY(points[i].y) * width_ + cellX(points[i].x)]++] = i;
+		}
+	}
+
+	void SpatialGrid::clear()
+	{
+		points_.clear();
+		cellStart_.clear();
+		items_.clear();
+		width_ = height_ = 0;
+	}
+
+	bool SpatialGrid::empty() const
+	{
+		return points_.empty();
+	}
+
+	std::vector<int> SpatialGrid::nearest(const sf::Vector2f pos, const int k, const int exclude) const
+	{
+		std::vector<int> result;
+		if (points_.empty() || k <= 0) return result;
+
+		//max-heap on distance, the top is the worst of the best k found so far
+		std::priority_queue<std::pair<float, int>> best;
+		const int cx{ std::clamp(cellX(pos.x), 0, width_ - 1) };
+		const int cy{ std::clamp(cellY(pos.y), 0, height_ - 1) };
+		const int maxRing{ std::max({ cx, cy, width_ - 1 - cx, height_ - 1 - cy }) };
+
+		const auto visit = [&](const int x, const int y)
+			{
+				if (x < 0 || y < 0 || x >= width_ || y >= height_) return;
+
+				const int cell{ y * width_ + x };
+				for (int i = cellStart_[cell]; i < cellStart_[cell + 1]; i++)
+				{
+					const int index{ items_[i] };
+					if (index == exclude) continue;
+
+					const sf::Vector2f delta{ points_[index] - pos };
+					const float distance{ delta.x * delta.x + delta.y * delta.y };
+					if (best.size() < static_cast<size_t>(k))
+					{
+						best.emplace(distance, index);
+					}
+					else if (distance < best.top().first)
+					{
+						best.pop();
+						best.emplace(distance, index);
+					}
+				}
+			};
+
+		for (int ring = 0; ring <= maxRing; ring++)
+		{
+			if (ring == 0)
+			{
+				visit(cx, cy);
+			}
+			else
+			{
+				for (int i = -ring; i <= ring; i++)
+				{
+					visit(cx + i, cy - ring);
+					visit(cx + i, cy + ring);
+				}
+				for (int i = -ring + 1; i < ring; i++)
+				{
+					visit(cx - ring, cy + i);
+					visit(cx + ring, cy + i);
+				}
+			}
+
+			//anything in the next ring is at least ring cells away
+			const float bound{ ring * cellSize_ };
+			if (best.size() == static_cast<size_t>(k) && best.top().first <= bound * bound) break;
+		}
+
+		result.resize(best.size());
+		for (auto it = result.rbegin(); it != result.rend(); ++it)
+		{
+			*it = best.top().second;
+			best.pop();
+		}
+
+		return result;
+	}
+}
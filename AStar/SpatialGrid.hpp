@@ -0,0 +1,102 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+
+namespace astar
+{
+	//Uniform bucket grid over a static point set, buckets are stored contiguously
+	class SpatialGrid
+	{
+	public:
+		SpatialGrid();
+		void build(const std::vector<sf::Vector2f>& points, const float cellSize);
+		void clear();
+		bool empty() const;
+		std::vector<int> nearest(const sf::Vector2f pos, const int k, const int exclude = -1) const;
+
+		//calls callback(index) for every point whose bucket overlaps the box from min to max, the caller tests the exact position
+		template<typename Callback>
+		void query(const sf::Vector2f min, const sf::Vector2f max, Callback&& callback) const
+		{
+			if (points_.empty()) return;
+
+			const int minX{ std::max(cellX(min.x), 0) };
+			const int minY{ std::max(cellY(min.y), 0) };
+			const int maxX{ std::min(cellX(max.x), width_ - 1) };
+			const int maxY{ std::min(cellY(max.y), height_ - 1) };
+
+			for (int y = minY; y <= maxY; y++)
+			{
+				for (int x = minX; x <= maxX; x++)
+				{
+					const int cell{ y * width_ + x };
+					for (int i = cellStart_[cell]; i < cellStart_[cell + 1]; i++)
+					{
+						callback(items_[i]);
+					}
+				}
+			}
+		}
+
+		//calls callback(cellCenter, count) for every non-empty bucket overlapping the box from min to max, for aggregate views
+		template<typename Callback>
+		void queryCells(const sf::Vector2f min, const sf::Vector2f max, Callback&& callback) const
+		{
+			if (points_.empty()) return;
+
+			const int minX{ std::max(cellX(min.x), 0) };
+			const int minY{ std::max(cellY(min.y), 0) };
+			const int maxX{ std::min(cellX(max.x), width_ - 1) };
+			const int maxY{ std::min(cellY(max.y), height_ - 1) };
+
+			for (int y = minY; y <= maxY; y++)
+			{
+				for (int x = minX; x <= maxX; x++)
+				{
+					const int cell{ y * width_ + x };
+					if (cellStart_[cell] != cellStart_[cell + 1])
+					{
+						callback(sf::Vector2f(origin_.x + (x + 0.5f) * cellSize_, origin_.y + (y + 0.5f) * cellSize_), cellStart_[cell + 1] - cellStart_[cell]);
+					}
+				}
+			}
+		}
+
+		//calls callback(index) for every point within radius of pos
+		template<typename Callback>
+		void queryRadius(const sf::Vector2f pos, const float radius, Callback&& callback) const
+		{
+			query({ pos.x - radius, pos.y - radius }, { pos.x + radius, pos.y + radius }, [&](const int index)
+				{
+					const sf::Vector2f delta{ points_[index] - pos };
+					if (delta.x * delta.x + delta.y * delta.y <= radius * radius)
+					{
+						callback(index);
+					}
+				});
+		}
+
+	private:
+		int cellX(const float x) const
+		{
+			return static_cast<int>(std::floor((x - origin_.x) / cellSize_));
+		}
+
+		int cellY(const float y) const
+		{
+			return static_cast<int>(std::floor((y - origin_.y) / cellSize_));
+		}
+
+		float cellSize_;
+		sf::Vector2f origin_;
+		int width_;
+		int height_;
+		std::vector<sf::Vector2f> points_;
+		std::vector<int> cellStart_; //bucket of cell c is items_[cellStart_[c], cellStart_[c + 1])
+		std::vector<int> items_;
+	};
+}
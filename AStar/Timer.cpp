@@ -1,13 +1,200 @@
 #include "Timer.hpp"
-#include <iostream>
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <map>
+#include <string_view>
 
 
+namespace
+{
+	//power of two buckets, bucket i holds durations below 2^i microseconds
+	struct Histogram
+	{
+		std::array<size_t, 40> buckets{};
+		size_t count{};
+		int64_t total{};
+		int64_t max{};
+
+		void add(const int64_t nanoseconds)
+		{
+			size_t bucket{};
+			for (int64_t microseconds = nanoseconds / 1000; microseconds > 0 && bucket + 1 < buckets.size(); microseconds >>= 1)
+			{
+				++bucket;
+			}
+
+			++buckets[bucket];
+			++count;
+			total += nanoseconds;
+			max = std::max(max, nanoseconds);
+		}
+
+		//upper bound of the bucket the fraction falls into, in microseconds
+		uint64_t percentile(const float fraction) const
+		{
+			const size_t rank{ static_cast<size_t>(fraction * count) };
+			size_t seen{};
+			for (size_t bucket = 0; bucket < buckets.size(); bucket++)
+			{
+				seen += buckets[bucket];
+				if (seen > rank) return uint64_t{ 1 } << bucket;
+			}
+
+			return uint64_t{ 1 } << (buckets.size() - 1);
+		}
+	};
+}
+
 namespace astar
 {
-	Timer::Timer(std::function<void()> callback, const long long delay) : callback_{callback}, delay_{delay}, start_{std::chrono::steady_clock::now()} {}
+	Timer::Timer(const char* name) : name_{ Profiler::get().recording() ? name : nullptr }, start_{ name_ ? Profiler::get().now() : 0 }
+	{
+	}
 
 	Timer::~Timer()
 	{
-		std::cout << std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-start_).count() << '\n';
+		if (name_ && Profiler::get().recording())
+		{
+			Profiler& profiler = Profiler::get();
+			profiler.record(name_, start_, profiler.now());
+		}
+	}
+
+	Profiler& Profiler::get()
+	{
+		static Profiler profiler;
+		return profiler;
+	}
+
+	Profiler::Profiler() : epoch_{ std::chrono::steady_clock::now() }, recording_{ false }, sessionStart_{}, nextThread_{}
+	{
+	}
+
+	bool Profiler::start()
+	{
+		if (recording_) return false;
+
+		sessionStart_ = now();
+		recording_.store(true, std::memory_order_release);
+		return true;
+	}
+
+	bool Profiler::recording() const
+	{
+		return recording_.load(std::memory_order_relaxed);
+	}
+
+	//scopes still open on other threads when recording stops are left out, rings of exited threads are dropped once read
+	bool Profiler::stop(const std::string& path, const std::function<void(const std::string&)>& print)
+	{
+		if (!recording_.exchange(false)) return false;
+
+		const int64_t sessionEnd{ now() };
+		std::vector<std::pair<uint32_t, Event>> events;
+		bool overwritten{};
+		{
+			std::scoped_lock lock(mutex_);
+			for (auto& ring : rings_)
+			{
+				const bool retired{ ring->retired.load(std::memory_order_acquire) }; //read first, its last events are then complete
+				const uint64_t head{ ring->head.load(std::memory_order_acquire) };
+				const uint64_t first{ head > ringCapacity_ ? head - ringCapacity_ : 0 };
+
+				for (uint64_t i = first; i < head; i++)
+				{
+					const Event& event = ring->events[i % ringCapacity_];
+					if (event.start >= sessionStart_ && event.end <= sessionEnd)
+					{
+						events.emplace_back(ring->thread, event);
+					}
+				}
+
+				overwritten |= first > 0 && ring->events[first % ringCapacity_].start >= sessionStart_;
+
+				if (retired)
+				{
+					ring.reset();
+				}
+			}
+			std::erase(rings_, nullptr);
+		}
+
+		std::ofstream file(path);
+		if (!file.is_open())
+		{
+			print("&&Rcan't open file '" + path + "'!");
+			return false;
+		}
+
+		std::ranges::sort(events, {}, [](const auto& event) { return event.second.start; });
+
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		for (size_t i = 0; i < events.size(); i++)
+		{
+			const auto& [thread, event] = events[i];
+			file << std::format("{}\n{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}", i ? "," : "",
+				event.name, thread, (event.start - sessionStart_) / 1000.0, (event.end - event.start) / 1000.0);
+		}
+		file << "\n]}\n";
+
+		std::map<std::string_view, Histogram> histograms;
+		for (const auto& [thread, event] : events)
+		{
+			histograms[event.name].add(event.end - event.start);
+		}
+
+		std::vector<std::pair<std::string_view, const Histogram*>> byTotal;
+		for (const auto& [name, histogram] : histograms)
+		{
+			byTotal.emplace_back(name, &histogram);
+		}
+		std::ranges::sort(byTotal, std::ranges::greater{}, [](const auto& entry) { return entry.second->total; });
+
+		print(std::format("&&G{} scopes over {:.3f}s written to file '{}'{}", events.size(), (sessionEnd - sessionStart_) / 1e9, path,
+			overwritten ? std::format(", only the newest {} per thread were kept", ringCapacity_) : ""));
+		for (const auto& [name, histogram] : byTotal)
+		{
+			print(std::format("&&G{}: {} calls, total {:.3f}ms, mean {:.1f}us, p50 <{}us, p99 <{}us, max {:.1f}us", name, histogram->count,
+				histogram->total / 1e6, histogram->total / 1e3 / histogram->count, histogram->percentile(0.5f), histogram->percentile(0.99f), histogram->max / 1e3));
+		}
+
+		return true;
+	}
+
+	int64_t Profiler::now() const
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch_).count();
+	}
+
+	void Profiler::record(const char* name, const int64_t start, const int64_t end)
+	{
+		Ring& ring = threadRing();
+		const uint64_t head{ ring.head.load(std::memory_order_relaxed) };
+		ring.events[head % ringCapacity_] = { name, start, end };
+		ring.head.store(head + 1, std::memory_order_release);
+	}
+
+	Profiler::Ring& Profiler::threadRing()
+	{
+		thread_local RingHandle handle;
+
+		if (!handle.ring)
+		{
+			handle.ring = std::make_shared<Ring>();
+			std::scoped_lock lock(mutex_);
+			handle.ring->thread = nextThread_++; //rings_ shrinks, its size would hand out an id twice
+			rings_.push_back(handle.ring);
+		}
+
+		return *handle.ring;
+	}
+
+	Profiler::RingHandle::~RingHandle()
+	{
+		if (ring)
+		{
+			ring->retired.store(true, std::memory_order_release);
+		}
 	}
 }
@@ -1,19 +1,78 @@
 #pragma once
 
-#include <functional>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 
 namespace astar
 {
+	//Records how long the enclosing scope took while the Profiler is recording, costs one atomic load otherwise.
+	//The name must outlive the recording, pass a string literal
 	class Timer
 	{
 	public:
-		Timer(std::function<void()> callback = std::function<void()>{}, long long delay = 0);
+		explicit Timer(const char* name);
 		~Timer();
+		Timer(const Timer&) = delete;
+		void operator=(const Timer&) = delete;
 	private:
-		std::function<void()> callback_;
-		long long delay_;
-		std::chrono::time_point<std::chrono::steady_clock> start_;
+		const char* name_; //nullptr when the profiler wasn't recording at construction
+		int64_t start_;
+	};
+
+	//Collects Timer scopes from every thread into per thread rings and writes them out as Chrome trace events
+	class Profiler
+	{
+	public:
+		void operator=(const Profiler&) = delete;
+		Profiler(const Profiler&) = delete;
+		static Profiler& get();
+		bool start();
+		bool stop(const std::string& path, const std::function<void(const std::string&)>& print);
+		bool recording() const;
+	private:
+		friend class Timer;
+
+		struct Event
+		{
+			const char* name;
+			int64_t start; //nanoseconds since epoch_
+			int64_t end;
+		};
+
+		//written only by its own thread, the newest ringCapacity_ events survive
+		struct Ring
+		{
+			std::array<Event, 1 << 16> events;
+			std::atomic<uint64_t> head{};
+			uint32_t thread;
+			std::atomic<bool> retired{}; //its thread exited, the next stop() drops it after writing its events out
+		};
+
+		//a thread's own reference to its ring, retires the ring when the thread exits
+		struct RingHandle
+		{
+			std::shared_ptr<Ring> ring;
+			~RingHandle();
+		};
+
+		Profiler();
+		int64_t now() const;
+		void record(const char* name, const int64_t start, const int64_t end);
+		Ring& threadRing();
+		static constexpr uint64_t ringCapacity_{ std::tuple_size_v<decltype(Ring::events)> };
+		const std::chrono::steady_clock::time_point epoch_;
+		std::atomic<bool> recording_;
+		int64_t sessionStart_; //events older than this belong to an earlier session
+		std::mutex mutex_;
+		std::vector<std::shared_ptr<Ring>> rings_; //shared with the thread_local handles, a ring outlives its thread until the next stop()
+		uint32_t nextThread_;
 	};
 }
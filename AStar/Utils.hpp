@@ -2,21 +2,64 @@
 
 #include <SFML/System/Vector2.hpp>
 #include <cmath>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <charconv>
+#include <optional>
+#include <string>
 
 namespace astar::utils
 {
-	static float euclidDistance(const sf::Vector2f v1, const sf::Vector2f v2)
+	inline float euclidDistanceSquared(const sf::Vector2f v1, const sf::Vector2f v2)
 	{
-		return std::sqrtf(std::powf(v1.x - v2.x, 2) + std::powf(v1.y - v2.y, 2));
+		const float dx{ v1.x - v2.x };
+		const float dy{ v1.y - v2.y };
+		return dx * dx + dy * dy;
 	}
 
-	static float euclidDistanceSquared(const sf::Vector2f v1, const sf::Vector2f v2)
+	inline float euclidDistance(const sf::Vector2f v1, const sf::Vector2f v2)
 	{
-		return std::powf(v1.x - v2.x, 2) + std::powf(v1.y - v2.y, 2);
+		return std::sqrt(euclidDistanceSquared(v1, v2));
 	}
 
-	static float getAngleDeg(const sf::Vector2f v1, const sf::Vector2f v2)
+	inline float getAngleDeg(const sf::Vector2f v1, const sf::Vector2f v2)
 	{
 		return std::atan2(v1.y - v2.y, v1.x - v2.x) * 57.30659025f;
 	}
-}
\ No newline at end of file
+
+	//SplitMix64 output for state x, consecutive states give statistically independent values
+	inline uint64_t splitMix64(uint64_t x)
+	{
+		x += 0x9E3779B97F4A7C15ull;
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+		return x ^ (x >> 31);
+	}
+
+	//seed of the stream-th generator derived from seed, depends only on the counter so any thread can produce it
+	inline uint64_t streamSeed(const uint64_t seed, const uint64_t stream)
+	{
+		return splitMix64(seed + stream * 0x9E3779B97F4A7C15ull);
+	}
+
+	//nearest-rank percentile of an ascending range, fraction in [0, 1]: the smallest value with at least fraction of the
+	//values at or below it, rank ceil(fraction * n) counted from 1
+	inline float percentile(const std::vector<float>& sorted, const float fraction)
+	{
+		if (sorted.empty()) return 0.f;
+
+		const float rank{ std::ceil(fraction * static_cast<float>(sorted.size())) };
+		return sorted[std::min(static_cast<size_t>(std::max(rank, 1.f)) - 1, sorted.size() - 1)];
+	}
+
+	//the whole string has to be a number
+	inline std::optional<uint64_t> parseUnsigned(const std::string& str)
+	{
+		uint64_t value;
+		const auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), value);
+		if (error != std::errc{} || end != str.data() + str.size()) return std::nullopt;
+
+		return value;
+	}
+}
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <fstream>
+#include <format>
+
+#include "Console.hpp"
+#include "JobSystem.hpp"
+#ifdef ASTAR_GRAPHICS
+#include "GraphRenderer.hpp"
+#endif
+#include <SFML/System/Clock.hpp>
+
+
+namespace
+{
+	//every line is a console command, background jobs finish before the next line runs, a server keeps running beside them
+	size_t runCommands(std::istream& is)
+	{
+		size_t commands{};
+		for (std::string line; std::getline(is, line);)
+		{
+			const size_t first{ line.find_first_not_of(" \t\r") };
+			if (first == std::string::npos || line[first] == '#') continue;
+
+			astar::Console::get().executeCommand(line);
+			astar::JobSystem::get().finish();
+			++commands;
+		}
+
+		return commands;
+	}
+}
+
+//Runs console commands without a window, from the files given as arguments or from stdin when there are none.
+//Results go to stdout and errors to stderr, the exit code is 1 if any command failed
+int main(int argc, char* argv[])
+{
+	std::ios_base::sync_with_stdio(0);
+	bool failed{ false };
+	astar::Console::get().setEcho(false);
+#ifdef ASTAR_GRAPHICS
+	astar::GraphRenderer::registerCommands();
+#endif
+	astar::Console::get().setOutput([&failed](const std::string_view line, const astar::Severity severity)
+		{
+			(severity == astar::Severity::Error ? std::cerr : std::cout) << line << std::endl; //a server never returns, its output can't wait for exit
+			failed |= severity == astar::Severity::Error;
+		});
+
+	sf::Clock clock;
+	size_t commands{};
+
+	if (argc < 2)
+	{
+		commands = runCommands(std::cin);
+	}
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::ifstream file(argv[i]);
+
+		if (!file.is_open())
+		{
+			std::cerr << "can't open file '" << argv[i] << "'!\n";
+			return 1;
+		}
+
+		commands += runCommands(file);
+	}
+
+	astar::JobSystem::get().finish(true); //a server started by the commands keeps the process alive until it's stopped
+	std::cout << std::format("ran {} commands in {}s\n", commands, clock.getElapsedTime().asSeconds());
+	return failed ? 1 : 0;
+}